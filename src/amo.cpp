@@ -0,0 +1,321 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Native at-most-one (AMO) constraints.  Pairwise encodings of AMO
+// constraints over 'k' literals need 'k(k-1)/2' binary clauses and each
+// literal of the constraint has 'k-1' binary watches.  Before search
+// continues we detect such cliques of irredundant binary clauses (greedily
+// in the graph where '-a -b' connects 'a' and 'b') and disconnect the
+// watches of the binary clauses of each clique with at least 'amominsize'
+// literals.  The clauses themselves stay in the clause data base, so all
+// simplification procedures as well as proofs still see them, but they
+// are not watched anymore.  During search a literal assigned to true in an
+// AMO constraint then assigns all other literals of the constraint to
+// false (see 'propagate_amos').
+//
+// Explanations are generated lazily.  Such an assignment only gets the
+// pseudo reason 'amo_reason' and we remember the AMO literal which forced
+// it in 'amoreasons'.  Only if conflict analysis actually needs the reason
+// it is replaced by the unwatched binary clause of the AMO constraint,
+// which is found by binary search in the sorted saved watches 'amobins'
+// of the forcing literal.  Thus neither a clause is allocated nor a
+// binary clause watched again during propagation.
+//
+// Since all simplification procedures might substitute, eliminate or
+// renumber variables, the AMO constraints are dropped ('reset_amos') and
+// the binary clauses reconnected before any of them runs and also when
+// leaving search.  They are detected again on the next return to search
+// on the root-level.
+//
+// Only pairwise encodings are recovered.  Sequential counter, ladder or
+// commander encodings introduce auxiliary variables and already propagate
+// through binary clauses over them.  Replacing them natively would need
+// new binary clauses as explanations, which would have to be traced in
+// proofs.  Cardinality constraints with bounds larger than one (at-most-k)
+// are not recovered either.
+
+Clause Internal::amo_reason;
+
+/*------------------------------------------------------------------------*/
+
+bool Internal::detecting_amos () {
+  if (!opts.amo) return false;
+  if (level) return false;
+  if (!amos.empty ()) return false;
+  if (last.amo.added != stats.added.irredundant) return true;
+  if (last.amo.fixed != stats.all.fixed) return true;
+  return last.amo.resets != stats.amoresets;
+}
+
+// Number of irredundant binary clauses '-lit -other' with 'other'
+// unassigned, which are not yet part of an AMO constraint.
+
+inline unsigned Internal::amo_degree (int lit) {
+  unsigned res = 0;
+  for (const auto & w : watches (-lit)) {
+    if (!w.binary ()) continue;
+    const Clause * c = w.clause;
+    if (c->redundant || c->garbage || c->amo) continue;
+    if (val (w.blit)) continue;
+    res++;
+  }
+  return res;
+}
+
+void Internal::detect_amos () {
+
+  assert (!level);
+  assert (watching ());
+  assert (amos.empty ());
+
+  START (amo);
+  stats.amophases++;
+
+  const unsigned min_size = opts.amominsize;
+  int64_t steps = opts.amomaxeff;
+
+  // Sort candidate literals by the number of binary clauses they occur in
+  // negatively, such that we start to grow cliques from the literals with
+  // the most neighbours.
+
+  vector<unsigned> degree (2 * vsize, 0);
+  vector<int> candidates;
+
+  for (auto idx : vars) {
+    if (!active (idx)) continue;
+    if (val (idx)) continue;
+    for (int sign = -1; sign <= 1; sign += 2) {
+      const int lit = sign * idx;
+      const unsigned d = amo_degree (lit);
+      steps -= watches (-lit).size ();
+      if (d + 1 < min_size) continue;
+      degree[vlit (lit)] = d;
+      candidates.push_back (lit);
+    }
+  }
+
+  stable_sort (candidates.begin (), candidates.end (),
+    [&] (int a, int b) { return degree[vlit (a)] > degree[vlit (b)]; });
+
+  vector<int64_t> seen (2 * vsize, 0);
+  int64_t stamp = 0;
+
+  vector<int> clique, neighbours;
+
+  for (const auto & lit : candidates) {
+
+    if (steps < 0) break;
+    if (amo_degree (lit) + 1 < min_size) continue;
+
+    assert (clique.empty ());
+    assert (neighbours.empty ());
+
+    for (const auto & w : watches (-lit)) {
+      if (!w.binary ()) continue;
+      const Clause * c = w.clause;
+      if (c->redundant || c->garbage || c->amo) continue;
+      if (val (w.blit)) continue;
+      neighbours.push_back (-w.blit);
+    }
+    steps -= watches (-lit).size ();
+
+    stable_sort (neighbours.begin (), neighbours.end (),
+      [&] (int a, int b) { return degree[vlit (a)] > degree[vlit (b)]; });
+
+    clique.push_back (lit);
+    mark (lit);
+
+    // A neighbour is added to the clique if it is connected to all the
+    // literals already in the clique.  Connected clique literals are only
+    // counted once (with 'seen') to be robust against duplicated binary
+    // clauses.
+
+    for (const auto & other : neighbours) {
+      if (steps < 0) break;
+      if (marked (other) > 0) continue;
+      if (marked (other) < 0) continue;
+      stamp++;
+      size_t connected = 0;
+      for (const auto & w : watches (-other)) {
+        if (!w.binary ()) continue;
+        const Clause * c = w.clause;
+        if (c->redundant || c->garbage || c->amo) continue;
+        const int member = -w.blit;
+        if (marked (member) <= 0) continue;
+        int64_t & s = seen[vlit (member)];
+        if (s == stamp) continue;
+        s = stamp;
+        connected++;
+      }
+      steps -= watches (-other).size ();
+      if (connected < clique.size ()) continue;
+      assert (connected == clique.size ());
+      clique.push_back (other);
+      mark (other);
+    }
+    neighbours.clear ();
+
+    if (clique.size () >= min_size) {
+
+      // Flag all binary clauses within the clique.  They are disconnected
+      // below, but stay in the clause data base.
+
+      for (const auto & member : clique) {
+        for (const auto & w : watches (-member)) {
+          if (!w.binary ()) continue;
+          Clause * c = w.clause;
+          if (c->redundant || c->garbage || c->amo) continue;
+          if (marked (-w.blit) <= 0) continue;
+          LOG (c, "AMO binary");
+          c->amo = true;
+          stats.amobins++;
+        }
+      }
+
+      LOG (clique, "found size %zd AMO constraint", clique.size ());
+      for (const auto & member : clique)
+        amos.push_back (member);
+      amos.push_back (0);
+      stats.amos++;
+    }
+
+    for (const auto & member : clique)
+      unmark (member);
+    clique.clear ();
+  }
+
+  if (!amos.empty ()) {
+
+    // Disconnect the flagged binary clauses, which both occur in the
+    // watches of negated AMO literals, and build the occurrence table.
+    // The disconnected watches are saved sorted by their blocking literal
+    // in order to find explanations (see 'find_amo_binary').
+
+    amotab.resize (2 * vsize);
+    amobins.resize (2 * vsize);
+    amoreasons.resize (vsize);
+
+    unsigned start = 0;
+    for (unsigned i = 0; i < amos.size (); i++) {
+      const int lit = amos[i];
+      if (!lit) { start = i + 1; continue; }
+      amotab[vlit (lit)].push_back (start);
+      Watches & ws = watches (-lit);
+      Watches & bs = amobins[vlit (lit)];
+      const size_t saved = bs.size ();
+      const auto end = ws.end ();
+      auto j = ws.begin ();
+      for (auto k = j; k != end; k++) {
+        const Watch & w = *k;
+        if (w.binary () && w.clause->amo) bs.push_back (w);
+        else *j++ = w;
+      }
+      ws.resize (j - ws.begin ());
+      if (bs.size () == saved) continue;
+      sort (bs.begin (), bs.end (),
+        [] (const Watch & a, const Watch & b) { return a.blit < b.blit; });
+    }
+
+    PHASE ("amo", stats.amophases,
+      "found %" PRId64 " AMO constraints replacing %" PRId64
+      " binary clauses", stats.amos, stats.amobins);
+  }
+
+  last.amo.added = stats.added.irredundant;
+  last.amo.fixed = stats.all.fixed;
+  last.amo.resets = stats.amoresets;
+
+  STOP (amo);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Drop all AMO constraints and reconnect their binary clauses.  Pending
+// pseudo reasons have to be explained before, since 'failing' and the
+// simplification procedures expect actual reason clauses.
+
+void Internal::reset_amos () {
+  if (amos.empty ()) return;
+  LOG ("resetting AMO constraints");
+  assert (watching ());
+  for (const auto & lit : trail)
+    if (var (lit).reason == &amo_reason)
+      explain_amo_assignment (lit);
+  for (const auto & idx : scores_bcp) {
+    const int lit = vals_bcp[idx] < 0 ? -idx : idx;
+    if (var (lit).reason == &amo_reason)
+      explain_amo_assignment (lit);
+  }
+  for (const auto & lit : amos) {
+    if (!lit) continue;
+    Watches & bs = amobins[vlit (lit)];
+    Watches & ws = watches (-lit);
+    for (const auto & w : bs) {
+      Clause * c = w.clause;
+      c->amo = false;
+      if (c->garbage) continue;
+      ws.push_back (w);
+    }
+    erase_vector (bs);
+  }
+  erase_vector (amos);
+  erase_vector (amotab);
+  erase_vector (amobins);
+  erase_vector (amoreasons);
+  stats.amoresets++;
+}
+
+// Garbage collection removes collected and updates moved binary clauses in
+// the saved watches of AMO literals as 'flush_watches' does for watches.
+// The blocking literals are not changed and thus the order is kept.
+
+void Internal::flush_amo_binaries () {
+  for (const auto & lit : amos) {
+    if (!lit) continue;
+    Watches & bs = amobins[vlit (lit)];
+    const auto end = bs.end ();
+    auto j = bs.begin ();
+    for (auto i = j; i != end; i++) {
+      Watch w = *i;
+      Clause * c = w.clause;
+      if (c->collect ()) continue;
+      if (c->moved) w.clause = c->copy;
+      *j++ = w;
+    }
+    bs.resize (j - bs.begin ());
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Find the unwatched binary clause '-lit implied' of an AMO constraint.
+
+Clause * Internal::find_amo_binary (int lit, int implied) {
+  const Watches & bs = amobins[vlit (lit)];
+  const auto end = bs.end ();
+  const auto i = lower_bound (bs.begin (), end, implied,
+    [] (const Watch & w, int blit) { return w.blit < blit; });
+  assert (i != end);
+  assert (i->blit == implied);
+  assert (!i->clause->garbage);
+  return i->clause;
+}
+
+// Replace the pseudo reason of the literal 'lit' assigned by an AMO
+// constraint by the actual binary clause.  This is called lazily in
+// conflict analysis through 'explained_reason' and in 'reset_amos'.
+
+void Internal::explain_amo_assignment (int lit) {
+  Var & v = var (lit);
+  assert (v.reason == &amo_reason);
+  const int other = amoreasons[vidx (lit)];
+  assert (val (other) > 0);
+  v.reason = find_amo_binary (other, lit);
+  LOG (v.reason, "explaining AMO assignment %d by", lit);
+  stats.amoexpls++;
+}
+
+}
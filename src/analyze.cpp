@@ -207,6 +207,10 @@ inline void Internal::bump_clause (Clause * c) {
   if (c->keep) return;
   if (c->hyper) return;
   if (!c->redundant) return;
+  if (opts.reduceactivity && c->activity < max_clause_activity) {
+    stats.activity++;
+    c->activity++;
+  }
   int new_glue = recompute_glue (c);
   if (new_glue < c->glue) promote_clause (c, new_glue);
   else if (used && c->glue <= opts.reducetier2glue) c->used = 2;
@@ -240,6 +244,7 @@ Internal::analyze_literal (int lit, int & open) {
   if (v.trail < l.seen.trail) l.seen.trail = v.trail;
   f.seen = true;
   analyzed.push_back (lit);
+  if (opts.lrb) lrb_participated (vidx (lit));
   LOG ("analyzed literal %d assigned at level %d", lit, v.level);
   if (v.level == level) open++;
 }
@@ -287,7 +292,7 @@ inline void Internal::bump_also_reason_literals (int lit, int limit) {
   const Var & v = var (lit);
   assert (val (lit));
   if (!v.level) return;
-  Clause * reason = v.reason;
+  Clause * reason = explained_reason (lit);
   if (!reason) return;
   for (const auto & other : *reason) {
     if (other == lit)  continue;
@@ -434,6 +439,13 @@ inline int Internal::find_conflict_level (int & forced) {
 
   LOG ("%d literals on actual conflict level %d", count, res);
 
+  // Clauses of native XOR constraints are not watched (see 'gauss.cpp').
+  //
+  if (conflict->parity) {
+    if (count != 1) forced = 0;
+    return res;
+  }
+
   const int size = conflict->size;
   int * lits = conflict->literals;
 
@@ -562,10 +574,19 @@ inline int Internal::determine_actual_backtrack_level (int jump) {
 
 /*------------------------------------------------------------------------*/
 
+// The literal signatures of the last learned clauses are kept in
+// 'eagersigs' in the same order as these clauses occur at the end of
+// 'clauses'.  Thus while walking backward over 'clauses' we can find the
+// signature of a recently learned clause by also walking backward in
+// 'eagersigs' in lock-step.  Clauses without cached signature are checked
+// as before.  The cache is reset during garbage collection.
+
 void Internal::eagerly_subsume_recently_learned_clauses (Clause * c) {
   assert (opts.eagersubsume);
   LOG (c, "trying eager subsumption with");
   mark (c);
+  const uint64_t sig = opts.subsumesig ? literal_signature (c) : 0;
+  auto sit = eagersigs.end ();
   int64_t lim = stats.eagertried + opts.eagersubsumelim;
   const auto begin = clauses.begin ();
   auto it = clauses.end ();
@@ -575,6 +596,9 @@ void Internal::eagerly_subsume_recently_learned_clauses (Clause * c) {
   while (it != begin && stats.eagertried++ <= lim) {
     Clause * d =  *--it;
     if (c == d) continue;
+    if (sit != eagersigs.begin () && sit[-1].clause == d) {
+      if (sig & ~(--sit)->sig) { stats.subsigs++; continue; }
+    }
     if (d->garbage) continue;
     if (!d->redundant) continue;
     int needed = c->size;
@@ -589,6 +613,12 @@ void Internal::eagerly_subsume_recently_learned_clauses (Clause * c) {
     mark_garbage (d);
   }
   unmark (c);
+  if (sig) {
+    const size_t keep = opts.eagersubsumelim;
+    if (eagersigs.size () >= 2*keep)
+      eagersigs.erase (eagersigs.begin (), eagersigs.end () - keep);
+    eagersigs.push_back (SigOcc (sig, c));
+  }
 #ifdef LOGGING
   uint64_t subsumed = stats.eagersub - before;
   if (subsumed) LOG ("eagerly subsumed %" PRIu64 " clauses", subsumed);
@@ -709,12 +739,14 @@ void Internal::analyze () {
       if (var (lit).level == level) uip = lit;
     }
     if (!--open) break;
-    reason = var (uip).reason;
+    reason = explained_reason (uip);
     LOG (reason, "analyzing %d reason", uip);
   }
   LOG ("first UIP %d", uip);
   clause.push_back (-uip);
 
+  if (opts.lrb) lrb_decay_alpha ();
+
   // Update glue and learned (1st UIP literals) statistics.
   //
   int size = (int) clause.size ();
@@ -723,6 +755,7 @@ void Internal::analyze () {
   UPDATE_AVERAGE (averages.current.glue.fast, glue);
   UPDATE_AVERAGE (averages.current.glue.slow, glue);
   rl_lbdsum += glue;
+  restartrl_lbdsum += glue;
   stats.learned.literals += size;
   stats.learned.clauses++;
   assert (glue < size);
@@ -769,6 +802,8 @@ void Internal::analyze () {
   else learn_empty_clause ();
 
   if (stable) reluctant.tick (); // Reluctant has its own 'conflict' counter.
+  if (opts.restartrl && restartpolicy == RestartPolicy::LUBY)
+    restartrl_luby.tick ();   // Luby sequence only advances while used.
 
   // Clean up.
   //
@@ -3,9 +3,10 @@
 namespace CaDiCaL {
 
 // The global assignment stack can only be (partially) reset through
-// 'backtrack' which is the only function using 'unassign' (inlined and thus
-// local to this file).  It turns out that 'unassign' does not need a
-// specialization for 'probe' nor 'vivify' and thus it is shared.
+// 'backtrack' and 'backtrack_trail' which are the only functions using
+// 'unassign' (inlined and thus local to this file).  It turns out that
+// 'unassign' does not need a specialization for 'probe' nor 'vivify' and
+// thus it is shared.
 
 inline void Internal::unassign (int lit) {
   assert (val (lit) > 0);
@@ -19,6 +20,10 @@ inline void Internal::unassign (int lit) {
   //
   if (!scores.contains (idx)) scores.push_back (idx);
 
+  // Learning rate based branching updates the score at this point.
+  //
+  if (opts.lrb) lrb_unassigned (idx);
+
   // For VMTF we need to update the 'queue.unassigned' pointer in case this
   // variable sits after the variable to which 'queue.unassigned' currently
   // points.  See our SAT'15 paper for more details on this aspect.
@@ -122,4 +127,23 @@ void Internal::backtrack (int new_level) {
   level = new_level;
 }
 
+// Unassign all literals assigned after the first 'assigned' literals on
+// the trail without changing the decision level.  This is used to undo
+// nested probes during tree based probing on decision level one.
+
+void Internal::backtrack_trail (size_t assigned) {
+  assert (level == 1);
+  assert ((size_t) control[level].trail <= assigned);
+  assert (assigned <= trail.size ());
+  LOG ("backtracking trail to %zd on decision level %d", assigned, level);
+  while (trail.size () > assigned) {
+    const int lit = trail.back ();
+    assert (var (lit).level == level);
+    trail.pop_back ();
+    unassign (lit);
+  }
+  if (propagated > assigned) propagated = assigned;
+  if (propagated2 > assigned) propagated2 = assigned;
+}
+
 }
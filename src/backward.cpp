@@ -34,6 +34,27 @@ Eliminator::~Eliminator () {
 
 /*------------------------------------------------------------------------*/
 
+// The variable signature of the clause at position 'pos' in the occurrence
+// list of 'lit' is cached in a parallel list.  The cached entry is still
+// valid if the same clause is found at the same position.  Since clauses
+// are only strengthened during elimination, an outdated signature is a
+// superset of the actual one and thus still a sound filter.  Otherwise
+// the signature is recomputed, which happens for instance if occurrence
+// lists are flushed or sorted.  The cache is reset after garbage
+// collection, since then clauses are moved or deallocated.
+
+uint64_t Eliminator::signature (int lit, size_t pos, Clause * c) {
+  if (sigs.empty ()) sigs.resize (2*internal->vsize);
+  SigOccs & cache = sigs[internal->vlit (lit)];
+  if (pos < cache.size () && cache[pos].clause == c) return cache[pos].sig;
+  const uint64_t res = variable_signature (c);
+  if (pos >= cache.size ()) cache.resize (pos + 1, SigOcc (0, 0));
+  cache[pos] = SigOcc (res, c);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
   assert (opts.elimbackward);
   assert (!c->redundant);
@@ -43,6 +64,7 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
   unsigned size = 0;
   int best = 0;
   bool satisfied = false;
+  uint64_t sig = 0;
   for (const auto & lit : *c) {
     const signed char tmp = val (lit);
     if (tmp > 0) { satisfied = true; break; }
@@ -50,9 +72,11 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
     size_t l = occs (lit).size ();
     LOG ("literal %d occurs %zd times", lit, l);
     if (l < len) best = lit, len = l;
+    sig |= variable_signature (lit);
     mark (lit);
     size++;
   }
+  if (!opts.subsumesig) sig = 0;
   if (satisfied) {
     LOG ("clause actually already satisfied");
     elim_update_removed_clause (eliminator, c);
@@ -63,8 +87,14 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
     assert (len);
     LOG ("literal %d has smallest number of occurrences %zd", best, len);
     LOG ("marked %d literals in clause of size %d", size, c->size);
-    for (auto & d : occs (best)) {
+    const Occs & os = occs (best);
+    for (size_t i = 0; i < os.size (); i++) {
+      Clause * d = os[i];
       if (d == c) continue;
+      if (sig && (sig & ~eliminator.signature (best, i, d))) {
+        stats.subsigs++;
+        continue;
+      }
       if (d->garbage) continue;
       if ((unsigned) d->size < size) continue;
       int negated = 0;
@@ -115,6 +145,7 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
           } else if (occs (negated).size () <= (size_t) opts.elimocclim) {
             strengthen_clause (d, negated);
             remove_occs (occs (negated), d);
+            lookup_insert (eliminator.lookup, d);
             elim_update_removed_lit (eliminator, negated);
             stats.elimbwstr++;
             assert (negated != best);
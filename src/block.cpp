@@ -11,6 +11,16 @@ namespace CaDiCaL {
 // irredundant clause in negated form before and has not been tried to use
 // as blocking literal since then.
 
+// Originally all irredundant clauses were connected in each round, even
+// though usually only few literals are scheduled.  In incremental mode
+// ('opts.blockinc') occurrences are only connected for scheduled literals
+// and their negations, which are the only ones needed to check whether
+// clauses are blocked on scheduled literals.  Literals which would be
+// rescheduled after blocking a clause but are not connected remain marked
+// as candidates for the next round instead.  Thus the cost of a round
+// (beyond one pass over the clauses) only depends on the literals touched
+// since the last round.
+
 /*------------------------------------------------------------------------*/
 
 inline bool block_more_occs_size::operator () (unsigned a, unsigned b) {
@@ -158,8 +168,28 @@ void Internal::block_schedule (Blocker & blocker)
       mark_skip (-lit);
   }
 
-  // Connect all literal occurrences in irredundant clauses.
+  // In incremental mode determine the literals to be connected, i.e.,
+  // the candidates to be scheduled below and their negations.
+  //
+  if (opts.blockinc) {
+    blocker.connected.resize (2*vsize, false);
+    for (auto idx : vars) {
+      if (!active (idx)) continue;
+      if (frozen (idx)) continue;
+      for (int sign = -1; sign <= 1; sign += 2) {
+        const int lit = sign * idx;
+        if (marked_skip (lit)) continue;
+        if (!marked_block (lit)) continue;
+        blocker.connected[vlit (lit)] = true;
+        blocker.connected[vlit (-lit)] = true;
+      }
+    }
+  }
+
+  // Connect all (needed) literal occurrences in irredundant clauses.
   //
+  size_t connected = 0;
+
   for (const auto & c : clauses) {
 
     if (c->garbage) continue;
@@ -168,7 +198,9 @@ void Internal::block_schedule (Blocker & blocker)
     for (const auto & lit : *c) {
       assert (active (lit));
       assert (!val (lit));
+      if (!blocker.connected_literal (vlit (lit))) continue;
       occs (lit).push_back (c);
+      connected++;
     }
   }
 
@@ -185,6 +217,10 @@ void Internal::block_schedule (Blocker & blocker)
     noccs (lit) = os.size ();
   }
 
+  PHASE ("block", stats.blockings,
+    "connected %zd occurrences in %s mode", connected,
+    opts.blockinc ? "incremental" : "full");
+
   // Now we fill the schedule (priority queue) of candidate literals to be
   // tried as blocking literals.  It is probably slightly faster to do this
   // in one go after all occurrences have been determined, instead of
@@ -584,6 +620,11 @@ Internal::block_reschedule_clause (Blocker & blocker, int lit, Clause * c)
 
   for (const auto & other : *c) {
 
+    // Without occurrences '-other' can only be tried in the next round
+    // (as candidate it was marked already in 'mark_garbage').
+    //
+    if (!blocker.connected_literal (vlit (-other))) continue;
+
     int64_t & n = noccs (other);
     assert (n > 0);
     n--;
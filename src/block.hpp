@@ -23,11 +23,21 @@ class Blocker {
   vector<struct Clause*> reschedule;
   BlockSchedule schedule;
 
+  // In incremental mode only literals in 'connected' (indexed by 'vlit')
+  // have occurrence lists and occurrence counters.  Otherwise all have.
+  //
+  vector<bool> connected;
+
   Blocker (Internal * i) : schedule (block_more_occs_size (i)) { }
 
+  bool connected_literal (unsigned ulit) const {
+    return connected.empty () || connected[ulit];
+  }
+
   void erase () {
     erase_vector (candidates);
     erase_vector (reschedule);
+    erase_vector (connected);
     schedule.erase ();
   }
 };
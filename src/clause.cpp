@@ -53,6 +53,8 @@ void Internal::mark_removed (Clause * c, int except) {
 
 inline void Internal::mark_added (int lit, int size, bool redundant) {
   mark_subsume (lit);
+  if (size == 2)
+    mark_decompose (lit);
   if (size == 3)
     mark_ternary (lit);
   if (!redundant)
@@ -66,6 +68,16 @@ void Internal::mark_added (Clause * c) {
     mark_added (lit, c->size, c->redundant);
 }
 
+// Binary clauses are edges of the binary implication graph, which is
+// decomposed including redundant binary clauses.  Thus their literals are
+// marked as 'decompose' roots even if they are not likely to be kept.
+
+void Internal::mark_decompose (Clause * c) {
+  assert (c->size == 2);
+  for (const auto & lit : *c)
+    mark_decompose (lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 Clause * Internal::new_clause (bool red, int glue) {
@@ -91,6 +103,7 @@ Clause * Internal::new_clause (bool red, int glue) {
   c->id = stats.added.total;
 #endif
 
+  c->amo = false;
   c->conditioned = false;
   c->covered = false;
   c->enqueued = false;
@@ -101,13 +114,16 @@ Clause * Internal::new_clause (bool red, int glue) {
   c->instantiated = false;
   c->keep = keep;
   c->moved = false;
+  c->parity = false;
   c->reason = false;
   c->redundant = red;
+  c->scheduled = false;
   c->transred = false;
   c->subsume = false;
   c->vivified = false;
   c->vivify = false;
   c->used = 0;
+  c->activity = 0;
 
   c->glue = glue;
   c->size = size;
@@ -136,6 +152,11 @@ Clause * Internal::new_clause (bool red, int glue) {
   LOG (c, "new pointer %p", (void*) c);
 
   if (likely_to_be_kept_clause (c)) mark_added (c);
+  else if (size == 2) mark_decompose (c);
+
+  // Learned clauses are found when vivification schedules are rebuilt.
+  //
+  if (!red) add_vivification_candidate (c);
 
   return c;
 }
@@ -165,6 +186,9 @@ void Internal::promote_clause (Clause * c, int new_glue) {
     LOG (c, "keeping with new glue %d in tier3", new_glue);
   stats.improvedglue++;
   c->glue = new_glue;
+  if (old_glue > opts.reducetier2glue &&
+      (c->keep || new_glue <= opts.reducetier2glue))
+    add_vivification_candidate (c);     // Moved from tier three to two.
 }
 
 /*------------------------------------------------------------------------*/
@@ -200,6 +224,7 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
   }
 
   if (likely_to_be_kept_clause (c)) mark_added (c);
+  else if (new_size == 2) mark_decompose (c);
 
   return res;
 }
@@ -414,6 +439,20 @@ Clause * Internal::new_hyper_ternary_resolved_clause (bool red) {
   return res;
 }
 
+// Add irredundant binary clause derived by Gaussian elimination in 'gauss'.
+// It is implied by the irredundant clauses but not necessarily 'RUP' and
+// thus not traced, which is why 'gauss' is skipped if a proof is traced.
+//
+Clause * Internal::new_gauss_binary_clause () {
+  external->check_learned_clause ();
+  assert (clause.size () == 2);
+  Clause * res = new_clause (false, 2);
+  assert (!proof);
+  assert (watching ());
+  watch_clause (res);
+  return res;
+}
+
 // Add a new clause with same glue and redundancy as 'orig' but literals are
 // assumed to be in 'clause' in 'decompose' and 'vivify'.
 //
@@ -422,6 +461,7 @@ Clause * Internal::new_clause_as (const Clause * orig) {
   const int new_glue = orig->glue;
   Clause * res = new_clause (orig->redundant, new_glue);
   assert (!orig->redundant || !orig->keep || res->keep);
+  if (res->redundant) add_vivification_candidate (res);  // strengthened
   if (proof) proof->add_derived_clause (res);
   assert (watching ());
   watch_clause (res);
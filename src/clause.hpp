@@ -27,6 +27,7 @@ struct Clause {
   int64_t id;         // Only useful for debugging.
 #endif
 
+  bool amo:1;         // Unwatched binary clause of at-most-one constraint.
   bool conditioned:1; // Tried for globally blocked clause elimination.
   bool covered:1;     // Already considered for covered clause elimination.
   bool enqueued:1;    // Enqueued on backward queue.
@@ -37,13 +38,16 @@ struct Clause {
   bool instantiated:1;// tried to instantiate
   bool keep:1;        // always keep this clause (if redundant)
   bool moved:1;       // moved during garbage collector ('copy' valid)
+  bool parity:1;      // Unwatched clause of native XOR constraint.
   bool reason:1;      // reason / antecedent clause can not be collected
   bool redundant:1;   // aka 'learned' so not 'irredundant' (original)
+  bool scheduled:1;   // in persistent vivification schedule
   bool transred:1;    // already checked for transitive reduction
   bool subsume:1;     // not checked in last subsumption round
   unsigned used:2;    // resolved in conflict analysis since last 'reduce'
   bool vivified:1;    // clause already vivified
   bool vivify:1;      // clause scheduled to be vivified
+  unsigned activity:12; // bumped in conflict analysis (see 'reduce.cpp')
 
   // The glucose level ('LBD' or short 'glue') is a heuristic value for the
   // expected usefulness of a learned clause, where smaller glue is consider
@@ -126,6 +130,10 @@ struct Clause {
   bool collect () const { return !reason && garbage; }
 };
 
+// Saturation limit of the clause 'activity' bit-field above.
+//
+const unsigned max_clause_activity = (1u << 12) - 1;
+
 struct clause_smaller_size {
   bool operator () (const Clause * a, const Clause * b) {
     return a->size < b->size;
@@ -134,6 +142,43 @@ struct clause_smaller_size {
 
 /*------------------------------------------------------------------------*/
 
+// Bloom filter style 64-bit clause signatures.  Each literal (or variable)
+// of a clause sets one bit given by a multiplicative hash of its index.  If
+// the signature of 'c' has a bit set which is not set in the signature of
+// 'd' then 'c' can not subsume 'd', which allows to skip the actual check
+// without touching the literals of 'd'.  Variable signatures ignore the
+// sign and thus can also be used to filter self-subsuming resolution
+// (strengthening) candidates.  Note that clauses only shrink, thus an
+// outdated signature is a superset of the actual one and still sound.
+
+inline uint64_t signature_bit (unsigned u) {
+  return (uint64_t) 1 << ((u * 2654435761u) >> 26);
+}
+
+inline uint64_t literal_signature (int lit) {
+  return signature_bit (2u * (unsigned) abs (lit) + (lit < 0));
+}
+
+inline uint64_t variable_signature (int lit) {
+  return signature_bit ((unsigned) abs (lit));
+}
+
+inline uint64_t literal_signature (const Clause * c) {
+  uint64_t res = 0;
+  for (const auto & lit : *c)
+    res |= literal_signature (lit);
+  return res;
+}
+
+inline uint64_t variable_signature (const Clause * c) {
+  uint64_t res = 0;
+  for (const auto & lit : *c)
+    res |= variable_signature (lit);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Place literals over the same variable close to each other.  This would
 // allow eager removal of identical literals and detection of tautological
 // clauses but is only currently used for better logging (see also
@@ -94,7 +94,7 @@ void Internal::protect_reasons () {
     Var & v = var (lit);
     assert (v.level > 0);
     Clause * reason = v.reason;
-    if (!reason) continue;
+    if (!reason || reason == &amo_reason || reason == &xor_reason) continue;
     LOG (reason, "protecting assigned %d reason %p", lit, (void*) reason);
     assert (!reason->reason);
     reason->reason = true;
@@ -119,7 +119,7 @@ void Internal::unprotect_reasons () {
     Var & v = var (lit);
     assert (v.level > 0);
     Clause * reason = v.reason;
-    if (!reason) continue;
+    if (!reason || reason == &amo_reason || reason == &xor_reason) continue;
     LOG (reason, "unprotecting assigned %d reason %p", lit, (void*) reason);
     assert (reason->reason);
     reason->reason = false;
@@ -194,6 +194,8 @@ void Internal::flush_all_occs_and_watches () {
     Watches tmp;
     for (auto idx : vars)
       flush_watches (idx, tmp), flush_watches (-idx, tmp);
+    flush_amo_binaries ();
+    flush_xor_clauses ();
   }
 }
 
@@ -206,7 +208,7 @@ void Internal::update_reason_references () {
     if (!active (lit)) continue;
     Var & v = var (lit);
     Clause * c = v.reason;
-    if (!c) continue;
+    if (!c || c == &amo_reason || c == &xor_reason) continue;
     LOG (c, "updating assigned %d reason", lit);
     assert (c->reason);
     assert (c->moved);
@@ -227,6 +229,7 @@ void Internal::update_reason_references () {
 void Internal::delete_garbage_clauses () {
 
   flush_all_occs_and_watches ();
+  flush_vivification_schedules ();
 
   LOG ("deleting garbage clauses");
   int64_t collected_bytes = 0, collected_clauses = 0;
@@ -354,6 +357,7 @@ void Internal::copy_non_garbage_clauses () {
 
   flush_all_occs_and_watches ();
   update_reason_references ();
+  flush_vivification_schedules ();
 
   // Replace and flush clause references in 'clauses'.
   //
@@ -419,6 +423,7 @@ void Internal::garbage_collection () {
   if (!protected_reasons) protect_reasons ();
   if (arenaing ()) copy_non_garbage_clauses ();
   else delete_garbage_clauses ();
+  eagersigs.clear ();
   check_clause_stats ();
   check_var_stats ();
   unprotect_reasons ();
@@ -152,33 +152,48 @@ struct Mapper {
 
 /*------------------------------------------------------------------------*/
 
-template <class Mapper, class ScoreType, class ScoreTable>
-static inline void remap_scores (Mapper& mapper, ScoreType& scores, ScoreTable& stab) {
-  vector<int> saved;
+// Map the elements of a score heap without changing the heap itself.  The
+// order of 'saved' elements does not matter, since the heap is rebuilt
+// bottom-up after the score table has been mapped too.
+
+template <class Mapper, class ScoreType>
+static inline void map_score_heap (Mapper& mapper, ScoreType& scores,
+                                   vector<int>& saved) {
   assert (saved.empty ());
-  if (!scores.empty ()) {
-    while (!scores.empty ()) {
-      const int src = scores.front ();
-      scores.pop_front ();
-      const int dst = mapper.map_idx (src);
-      if (!dst) continue;
-      if (src == mapper.first_fixed) continue;
-      saved.push_back (dst);
-    }
-    scores.erase ();
+  for (const auto src : scores) {
+    const int dst = mapper.map_idx (src);
+    if (!dst) continue;
+    if ((int) src == mapper.first_fixed) continue;
+    saved.push_back (dst);
   }
+  scores.erase ();
+}
+
+template <class ScoreType>
+static inline bool rebuild_score_heap (ScoreType& scores,
+                                       const vector<int>& saved) {
+  if (saved.empty ()) return false;
+  scores.build (saved);
+  scores.shrink ();
+  return true;
+}
+
+template <class Mapper, class ScoreType, class ScoreTable>
+static inline bool remap_scores (Mapper& mapper, ScoreType& scores, ScoreTable& stab) {
+  vector<int> saved;
+  map_score_heap (mapper, scores, saved);
   mapper.map_vector (stab);
-  if (!saved.empty ()) {
-    for (const auto idx : saved)
-      scores.push_back (idx);
-    scores.shrink ();
-  }
+  return rebuild_score_heap (scores, saved);
 }
 
 static signed char * ignore_clang_analyze_memory_leak_warning;
 
 void Internal::compact () {
 
+  reset_amos ();
+  reset_xors ();
+  stop_walk_thread ();
+  reset_vivification_schedules ();
   START (compact);
 
   assert (active () < max_var);
@@ -399,17 +414,30 @@ void Internal::compact () {
   // In the fourth part we map the binary heap for scores.
   /*======================================================================*/
 
-  // The simplest way to map a binary heap is to get all elements from the
-  // heap and reinsert them.  This could be slightly improved in terms of
-  // speed if we add a 'flush (int * map)' function to 'Heap', but that is
-  // pretty complicated and would require that the 'Heap' knows that mapped
-  // elements with 'zero' destination should be flushed.
-
-  remap_scores (mapper, scores, stab);
+  // We simply collect the mapped elements of a binary heap and rebuild it
+  // in linear time after mapping its score table.  This could be slightly
+  // improved in terms of memory if we add a 'flush (int * map)' function to
+  // 'Heap', but that is pretty complicated and would require that the
+  // 'Heap' knows that mapped elements with 'zero' destination should be
+  // flushed.
+
+  stats.heapified += remap_scores (mapper, scores, stab);
+  if (opts.lrb) {
+    stats.heapified += remap_scores (mapper, lrbs, ltab);
+    mapper.map_vector (lrbtab);
+  }
 #if PBCP_ORDER == PBCP_ORDER_BRANCHING
-  remap_scores (mapper, scores_bcp, stab);
+  {
+    // The priority BCP heap shares the score tables of the decision
+    // heuristics which thus are already mapped and must not be mapped
+    // twice.
+    //
+    vector<int> saved;
+    map_score_heap (mapper, scores_bcp, saved);
+    stats.heapified += rebuild_score_heap (scores_bcp, saved);
+  }
 #else
-  remap_scores (mapper, scores_bcp, stab_bcp);
+  stats.heapified += remap_scores (mapper, scores_bcp, stab_bcp);
 #endif
 
   /*----------------------------------------------------------------------*/
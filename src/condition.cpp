@@ -449,76 +449,16 @@ long Internal::condition_round (long delta) {
   // Also, see below, we might need to consider the negation of unassigned
   // literals in candidate clauses as being watched.
 
-  // Now try to block all candidate clauses.
+  // Refine the current partition for the candidate clause 'c' (with its
+  // literals marked) until a fix-point is reached, the propagation limit
+  // is hit or no autarky literal is left in the candidate.  Returns the
+  // watched autarky literal of the candidate (zero if none is left).
+  // Without candidate ('c' zero) all conditional literals are unassigned
+  // and the refinement only stops at the fix-point or the limit.
   //
-  long blocked = 0;             // Number of Successfully blocked clauses.
-  //
-  size_t untried = candidates.size ();
-  for (const auto & c : candidates) {
-
-    if (initial.autarky <= 0) break;
-
-    if (c->reason) continue;
-
-    bool terminated_or_limit_hit = true;
-    if (terminated_asynchronously ())
-      LOG ("asynchronous termination detected");
-    else if (stats.condprops >= limit)
-      LOG ("condition propagation limit %ld hit", limit);
-    else terminated_or_limit_hit = false;
-
-    if (terminated_or_limit_hit) {
-      PHASE ("condition", stats.conditionings,
-        "%zd candidates %.0f%% not tried after %ld propagations",
-        untried, percent (untried, candidates.size ()), props);
-      break;
-    }
-    untried--;
-
-    assert (!c->garbage);
-    assert (!c->redundant);
-
-    LOG (c, "candidate");
-    c->conditioned = 1;                 // Next time later.
-
-    // We watch an autarky literal in the clause, and can stop trying to
-    // globally block the clause as soon it turns into a conditional
-    // literal and we can not find another one.  If the fix-point assignment
-    // is reached and we still have an autarky literal left the watched one
-    // is reported as witness for this clause being globally blocked.
-    //
-    int watched_autarky_literal = 0;
-
-    // First mark all true literals in the candidate clause and find an
-    // autarky literal which witnesses that this clause has still a chance
-    // to be globally blocked.
-    //
-    for (const_literal_iterator l = c->begin (); l != c->end (); l++)
-    {
-      const int lit = *l;
-      mark_in_candidate_clause (lit);
-      if (watched_autarky_literal) continue;
-      if (!is_autarky_literal (lit)) continue;
-      watched_autarky_literal = lit;
-
-      // TODO assign non-assigned literals to false?
-      // Which might need to trigger watching additional clauses.
-    }
-
-    if (!watched_autarky_literal) {
-      LOG ("no initial autarky literal found");
-      for (const_literal_iterator l = c->begin (); l != c->end (); l++)
-        unmark_in_candidate_clause (*l);
-      continue;
-    }
-
-    stats.condcands++;          // Only now ...
-
-    LOG ("watching first autarky literal %d", watched_autarky_literal);
+  auto refine = [&] (Clause * c, int watched_autarky_literal) {
 
-    // Save assignment sizes for statistics, logging and checking.
-    //
-    remain = initial;
+    bool alive = true;          // Candidate has autarky literal left.
 
     // Position of next conditional and unassigned literal to process in the
     // 'conditional' and the 'unassigned' stack.
@@ -528,7 +468,7 @@ long Internal::condition_round (long delta) {
     assert (unassigned.empty ());
     assert (conditional.size () == initial.conditional);
 
-    while (watched_autarky_literal &&
+    while (alive &&
            stats.condprops < limit &&
            next.conditional < conditional.size ()) {
 
@@ -555,7 +495,7 @@ long Internal::condition_round (long delta) {
       remain.conditional--;
       remain.assigned--;
 
-      while (watched_autarky_literal &&
+      while (alive &&
              stats.condprops < limit &&
              next.unassigned < unassigned.size ())
       {
@@ -580,11 +520,15 @@ long Internal::condition_round (long delta) {
         //
         auto i = os.begin (), j = i;
         for (;
-             watched_autarky_literal && j != os.end ();
+             alive && j != os.end ();
              j++)
         {
           Clause * d = *i++ = *j;
 
+          // Eliminated clauses are not part of the formula anymore.
+          //
+          if (d->garbage) { i--; continue; }
+
           int replacement = 0;  // New watched literal in 'd'.
           int negative = 0;     // Negative autarky literals in 'd'.
 
@@ -623,7 +567,7 @@ long Internal::condition_round (long delta) {
           LOG (d, "found %d negative autarky literals in", negative);
 
           for (const_literal_iterator l = d->begin ();
-               watched_autarky_literal && l != d->end ();
+               alive && l != d->end ();
                l++)
           {
             const int lit = *l;
@@ -657,7 +601,7 @@ long Internal::condition_round (long delta) {
               watched_autarky_literal = replacement;
             } else {
               LOG ("failed to find an autarky replacement");
-              watched_autarky_literal = 0; // Breaks out of 4 loops!!!!!
+              alive = false;            // Breaks out of 4 loops!!!!!
             }
           } // End of loop of turning autarky literals into conditionals.
         } // End of loop of all watched clauses of an unassigned literal.
@@ -674,6 +618,235 @@ long Internal::condition_round (long delta) {
       } // End of loop which goes over all unprocessed unassigned literals.
     } // End of loop which goes over all unprocessed conditional literals.
 
+    return alive ? watched_autarky_literal : 0;
+  };
+
+  // Get back to the initial assignment and reset conditionals after
+  // refining the partition.  First we assign all the unassigned literals
+  // (if necessary).
+  //
+  auto reset = [&] () {
+
+    if (!unassigned.empty ()) {
+      LOG ("reassigning %zd literals", unassigned.size ());
+      while (!unassigned.empty ()) {
+        const int lit = unassigned.back ();
+        unassigned.pop_back ();
+        condition_assign (lit);
+      }
+    }
+
+    // Then we remove from the conditional stack autarky literals which
+    // became conditional and also reset their 'conditional' bit.
+    //
+    if (initial.conditional < conditional.size ()) {
+      LOG ("flushing %zd autarky literals from conditional stack",
+        conditional.size () - initial.conditional);
+      while (initial.conditional < conditional.size ()) {
+        const int lit = conditional.back ();
+        conditional.pop_back ();
+        unmark_as_conditional_literal (lit);
+      }
+    }
+  };
+
+  long blocked = 0;             // Number of Successfully blocked clauses.
+
+  // Before trying candidates individually we refine the initial partition
+  // without candidate, i.e., unassign all conditional literals.  What
+  // remains is a pure autarky (with empty conditional part) of the formula
+  // and all candidates with a literal in it are globally blocked with this
+  // autarky as witness.  This single refinement is shared by all these
+  // candidates, which otherwise need their own (about as expensive)
+  // refinement each.  Watches of eliminated clauses are dropped during
+  // later refinements, which thus work on the reduced formula.
+  //
+  if (opts.conditionpure && initial.autarky > 0) {
+
+    remain = initial;
+    refine (0, 0);
+
+    LOG ("pure autarky of size %zd", remain.autarky);
+
+    if (stats.condprops < limit && remain.autarky > 0) {
+
+      assert (!remain.conditional);
+      assert (remain.assigned == remain.autarky);
+
+      // Flipping the whole pure autarky is not necessary to satisfy one
+      // removed clause.  It is enough to flip the autarky literals
+      // connected to one of its autarky literals, where a clause with a
+      // negated autarky literal connects all its autarky variables, since
+      // it has to stay satisfied.  Such a component is an autarky too.  We
+      // compute these components once with union-find and push only the
+      // smallest component of an eliminated clause as its witness (for
+      // pure literals this is just the literal itself).  Building the
+      // components and pushing witnesses is charged to the limit.
+      //
+      vector<int> repr (max_var + 1, 0);
+      for (const auto & lit : trail)
+        if (is_autarky_literal (lit))
+          repr[vidx (lit)] = vidx (lit);
+
+      auto find = [&] (int idx) {
+        assert (repr[idx]);
+        while (repr[idx] != idx)
+          idx = repr[idx] = repr[repr[idx]];
+        return idx;
+      };
+
+      vector<int> connected;
+      for (const auto & d : clauses) {
+        if (d->garbage || d->redundant) continue;
+        props++;
+        stats.condprops++;
+        bool negative = false;
+        for (const auto & lit : *d) {
+          if (is_autarky_literal (lit)) connected.push_back (vidx (lit));
+          else if (is_autarky_literal (-lit))
+            connected.push_back (vidx (lit)), negative = true;
+        }
+        if (negative && connected.size () > 1) {
+          const int root = find (connected[0]);
+          for (const auto & idx : connected) {
+            const int other = find (idx);
+            if (other != root) repr[other] = root;
+          }
+        }
+        connected.clear ();
+      }
+
+      // Collect the members of each component consecutively in 'members'
+      // starting at 'start[root]' with 'size[root]' members.
+      //
+      vector<unsigned> start (max_var + 1, 0), size (max_var + 1, 0);
+      for (const auto & lit : trail)
+        if (is_autarky_literal (lit))
+          size[find (vidx (lit))]++;
+      unsigned offset = 0;
+      for (int idx = 1; idx <= max_var; idx++)
+        start[idx] = offset, offset += size[idx];
+      vector<int> members (offset);
+      {
+        vector<unsigned> next = start;
+        for (const auto & lit : trail)
+          if (is_autarky_literal (lit))
+            members[next[find (vidx (lit))]++] = lit;
+      }
+
+      for (const auto & c : candidates) {
+
+        if (stats.condprops >= limit) break;
+        if (c->reason) continue;
+
+        int root = 0;
+        for (const auto & lit : *c) {
+          if (!is_autarky_literal (lit)) continue;
+          const int other = find (vidx (lit));
+          if (!root || size[other] < size[root]) root = other;
+        }
+        if (!root) continue;
+
+        blocked++;
+        stats.conditioned++;
+        stats.condpure++;
+        LOG (c, "pure autarky component of size %u satisfies", size[root]);
+
+        external->push_zero_on_extension_stack ();
+        for (unsigned i = start[root]; i < start[root] + size[root]; i++)
+          external->push_witness_literal_on_extension_stack (members[i]);
+        external->push_clause_on_extension_stack (c);
+
+        mark_garbage (c);
+
+        props += size[root];
+        stats.condprops += size[root];
+
+        stats.condassrem += size[root];
+        stats.condautrem += size[root];
+        stats.condassirem += initial.assigned;
+      }
+
+      PHASE ("condition", stats.conditionings,
+        "pure autarky of size %zd satisfies %ld candidates %.0f%%",
+        remain.autarky, blocked, percent (blocked, candidates.size ()));
+    }
+
+    reset ();
+  }
+
+  // Now try to block all remaining candidate clauses.
+  //
+  size_t untried = candidates.size ();
+  for (const auto & c : candidates) {
+
+    if (initial.autarky <= 0) break;
+
+    if (c->garbage) continue;
+    if (c->reason) continue;
+
+    bool terminated_or_limit_hit = true;
+    if (terminated_asynchronously ())
+      LOG ("asynchronous termination detected");
+    else if (stats.condprops >= limit)
+      LOG ("condition propagation limit %ld hit", limit);
+    else terminated_or_limit_hit = false;
+
+    if (terminated_or_limit_hit) {
+      PHASE ("condition", stats.conditionings,
+        "%zd candidates %.0f%% not tried after %ld propagations",
+        untried, percent (untried, candidates.size ()), props);
+      break;
+    }
+    untried--;
+
+    assert (!c->garbage);
+    assert (!c->redundant);
+
+    LOG (c, "candidate");
+    c->conditioned = 1;                 // Next time later.
+
+    // We watch an autarky literal in the clause, and can stop trying to
+    // globally block the clause as soon it turns into a conditional
+    // literal and we can not find another one.  If the fix-point assignment
+    // is reached and we still have an autarky literal left the watched one
+    // is reported as witness for this clause being globally blocked.
+    //
+    int watched_autarky_literal = 0;
+
+    // First mark all true literals in the candidate clause and find an
+    // autarky literal which witnesses that this clause has still a chance
+    // to be globally blocked.
+    //
+    for (const_literal_iterator l = c->begin (); l != c->end (); l++)
+    {
+      const int lit = *l;
+      mark_in_candidate_clause (lit);
+      if (watched_autarky_literal) continue;
+      if (!is_autarky_literal (lit)) continue;
+      watched_autarky_literal = lit;
+
+      // TODO assign non-assigned literals to false?
+      // Which might need to trigger watching additional clauses.
+    }
+
+    if (!watched_autarky_literal) {
+      LOG ("no initial autarky literal found");
+      for (const_literal_iterator l = c->begin (); l != c->end (); l++)
+        unmark_in_candidate_clause (*l);
+      continue;
+    }
+
+    stats.condcands++;          // Only now ...
+
+    LOG ("watching first autarky literal %d", watched_autarky_literal);
+
+    // Save assignment sizes for statistics, logging and checking.
+    //
+    remain = initial;
+
+    watched_autarky_literal = refine (c, watched_autarky_literal);
+
     // We are still processing the candidate 'c' and now have reached a
     // final fix-point assignment partitioned into a conditional and an
     // autarky part, or during unassigned literals figured that there is no
@@ -770,30 +943,9 @@ long Internal::condition_round (long delta) {
     }
 
     // In this last part specific to one candidate clause, we have to get
-    // back to the initial assignment and reset conditionals.  First we
-    // assign all the unassigned literals (if necessary).
+    // back to the initial assignment and reset conditionals.
     //
-    if (!unassigned.empty ()) {
-      LOG ("reassigning %zd literals", unassigned.size ());
-      while (!unassigned.empty ()) {
-        const int lit = unassigned.back ();
-        unassigned.pop_back ();
-        condition_assign (lit);
-      }
-    }
-
-    // Then we remove from the conditional stack autarky literals which
-    // became conditional and also reset their 'conditional' bit.
-    //
-    if (initial.conditional < conditional.size ()) {
-      LOG ("flushing %zd autarky literals from conditional stack",
-        conditional.size () - initial.conditional);
-      while (initial.conditional < conditional.size ()) {
-        const int lit = conditional.back ();
-        conditional.pop_back ();
-        unmark_as_conditional_literal (lit);
-      }
-    }
+    reset ();
 
     // Finally unmark all literals in the candidate clause.
     //
@@ -858,6 +1010,8 @@ long Internal::condition_round (long delta) {
 void Internal::condition (bool update_limits) {
 
   if (unsat) return;
+  reset_amos ();
+  reset_xors ();
   if (!stats.current.irredundant) return;
 
   START_SIMPLIFIER (condition, CONDITION);
@@ -21,6 +21,16 @@ namespace CaDiCaL {
 // found during ALA steps or if during a CLA step all resolution candidates
 // of a literal on the trail are satisfied (the extended clause is blocked).
 
+// Candidates usually share many literals and thus ALA steps over binary
+// clauses traverse the same parts of the binary implication graph again
+// and again.  Unless 'opts.covercache' is disabled we compute the closure
+// of a literal in the binary implication graph once and cache it in the
+// 'implied' arena for the rest of the round.  Each entry starts with the
+// number of implied literals (or '-1' if the closure exceeds the limit
+// 'opts.coveraddlim') followed by the implied literals.  Eliminating a
+// binary clause invalidates all cached closures, which is implemented by
+// incrementing 'epoch' (and flushing the arena).
+
 struct Coveror
 {
   std::vector<int> added;        // acts as trail
@@ -28,11 +38,29 @@ struct Coveror
   std::vector<int> covered;      // clause literals or added through CLA
   std::vector<int> intersection; // of literals in resolution candidates
 
+  std::vector<int> implied;      // arena of cached closures
+  std::vector<size_t> offsets;   // closure offset in 'implied' per literal
+  std::vector<unsigned> stamps;  // epoch in which closure was computed
+  std::vector<bool> closed;      // closure already added (per variable)
+  unsigned epoch;                // valid closures have this stamp
+
   size_t alas, clas;             // actual number of ALAs and CLAs
 
   struct { size_t added, covered; } next;       // propagate next ...
 
-  Coveror () : alas (0), clas (0) { }
+  Coveror () : epoch (1), alas (0), clas (0) { }
+
+  void flush_closures () { implied.clear (); epoch++; }
+};
+
+// Candidates are tried with priority on those having a literal with few
+// resolution candidates ('resolvents' below), since for those it is more
+// likely that covered literal addition succeeds early.
+
+struct CoverCandidate
+{
+  Clause * clause;
+  size_t resolvents;             // minimum number of resolution candidates
 };
 
 /*------------------------------------------------------------------------*/
@@ -97,6 +125,9 @@ Internal::asymmetric_literal_addition (int lit, Coveror & coveror)
 // this function is also a hot-spot here in 'cover' we specialize it in the
 // same spirit as 'probe_propagate' and 'vivify_propagate'.  Please refer to
 // the detailed comments for 'propagate' in 'propagate.cpp' for details.
+// If the closure of 'lit' in the binary implication graph has already
+// been added (see 'cover_propagate_closure') its binary watches can not
+// add further literals and are skipped.
 
 bool
 Internal::cover_propagate_asymmetric (int lit,
@@ -107,6 +138,7 @@ Internal::cover_propagate_asymmetric (int lit,
   stats.propagations.cover++;
   assert (val (lit) < 0);
   bool subsumed = false;
+  const bool closed = opts.covercache && coveror.closed[vidx (lit)];
   LOG ("asymmetric literal propagation of %d", lit);
   Watches & ws = watches (lit);
   const const_watch_iterator eow = ws.end ();
@@ -114,6 +146,7 @@ Internal::cover_propagate_asymmetric (int lit,
   const_watch_iterator i = j;
   while (!subsumed && i != eow) {
     const Watch w = *j++ = *i++;
+    if (closed && w.binary ()) continue;
     if (w.clause == ignore) continue;   // costly but necessary here ...
     const signed char b = val (w.blit);
     if (b > 0) continue;
@@ -305,6 +338,109 @@ Internal::cover_propagate_covered (int lit, Coveror & coveror)
 
 /*------------------------------------------------------------------------*/
 
+// Determine the cached closure of literals added through ALA steps over
+// binary clauses if 'lit' is assigned to false, i.e., all literals
+// reachable from 'lit' in the binary implication graph.  This is a pure
+// graph traversal independent of the current assignment and returns the
+// offset of the closure entry in 'coveror.implied'.
+
+size_t Internal::cover_closure (int lit, Coveror & coveror)
+{
+  const unsigned ulit = vlit (lit);
+  if (coveror.stamps[ulit] == coveror.epoch) {
+    stats.cover.cached++;
+    return coveror.offsets[ulit];
+  }
+
+  // Avoid the arena to grow without bound.
+  //
+  if (coveror.implied.size () > 16 * (size_t) vsize)
+    coveror.flush_closures ();
+
+  stats.cover.closures++;
+
+  auto & implied = coveror.implied;
+  const size_t res = implied.size ();
+  implied.push_back (0);
+  const size_t limit = opts.coveraddlim;
+
+  mark2 (lit);
+  size_t next = res + 1;
+  bool complete = true;
+  int other = lit;
+
+  for (;;) {
+    stats.propagations.cover++;
+    for (const auto & w : watches (other)) {
+      if (!w.binary ()) continue;
+      if (w.clause->garbage) continue;
+      const int added = -w.blit;
+      if (marked2 (added)) continue;
+      if (implied.size () - res > limit) { complete = false; break; }
+      mark2 (added);
+      implied.push_back (added);
+    }
+    if (!complete) break;
+    if (next == implied.size ()) break;
+    other = implied[next++];
+  }
+
+  unmark (lit);
+  for (size_t i = res + 1; i < implied.size (); i++)
+    unmark (implied[i]);
+
+  if (complete) {
+    implied[res] = implied.size () - res - 1;
+    LOG ("closure of %d in binary implication graph has %d literals",
+      lit, implied[res]);
+  } else {
+    implied.resize (res + 1);
+    implied[res] = -1;
+    LOG ("closure of %d in binary implication graph too large", lit);
+  }
+
+  coveror.stamps[ulit] = coveror.epoch;
+  coveror.offsets[ulit] = res;
+
+  return res;
+}
+
+// Add all literals of the cached closure of 'lit' at once.  The closure is
+// transitively closed and thus the literals added do not need to have
+// their closure added again.  Returns 'true' if a conflict is found, that
+// is the extended clause is an asymmetric tautology.
+
+bool Internal::cover_propagate_closure (int lit, Coveror & coveror)
+{
+  require_mode (COVER);
+  assert (val (lit) < 0);
+  if (coveror.closed[vidx (lit)]) return false;
+
+  const size_t offset = cover_closure (lit, coveror);
+  const int size = coveror.implied[offset];
+  if (size < 0) return false;
+
+  coveror.closed[vidx (lit)] = true;
+
+  const int * const begin = coveror.implied.data () + offset + 1;
+  const int * const end = begin + size;
+
+  for (const int * p = begin; p != end; p++) {
+    const int other = *p;
+    const signed char tmp = val (other);
+    if (tmp > 0) {
+      LOG ("binary implication closure of %d conflicts", lit);
+      return true;
+    }
+    coveror.closed[vidx (other)] = true;
+    if (!tmp) asymmetric_literal_addition (other, coveror);
+  }
+
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+
 bool Internal::cover_clause (Clause * c, Coveror & coveror) {
 
   require_mode (COVER);
@@ -339,10 +475,23 @@ bool Internal::cover_clause (Clause * c, Coveror & coveror) {
 
   coveror.next.added = coveror.next.covered = 0;
 
+  // Binary candidates have to be ignored during propagation, which is not
+  // possible with cached closures (which might contain the candidate).
+  //
+  const bool closures = opts.covercache && c->size > 2;
+
   while (!tautological) {
+    if (coveror.added.size () > (size_t) opts.coveraddlim) {
+      LOG (c, "extended clause too large for");
+      stats.cover.aborted++;
+      break;
+    }
     if (coveror.next.added < coveror.added.size ()) {
       const int lit = coveror.added[coveror.next.added++];
-      tautological = cover_propagate_asymmetric (lit, c, coveror);
+      if (closures)
+        tautological = cover_propagate_closure (lit, coveror);
+      if (!tautological)
+        tautological = cover_propagate_asymmetric (lit, c, coveror);
     } else if (coveror.next.covered < coveror.covered.size ()) {
       const int lit = coveror.covered[coveror.next.covered++];
       tautological = cover_propagate_covered (lit, coveror);
@@ -373,13 +522,19 @@ bool Internal::cover_clause (Clause * c, Coveror & coveror) {
         prev = other;
       }
     }
+    if (c->size == 2 && opts.covercache) {
+      LOG ("flushing binary implication closures");
+      coveror.flush_closures ();
+    }
   }
 
   // Backtrack and 'unassign' all literals.
 
   assert (level == 1);
-  for (const auto & lit : coveror.added)
+  for (const auto & lit : coveror.added) {
     vals[lit] = vals[-lit] = 0;
+    if (closures) coveror.closed[vidx (lit)] = false;
+  }
   level = 0;
 
   coveror.covered.clear ();
@@ -391,13 +546,17 @@ bool Internal::cover_clause (Clause * c, Coveror & coveror) {
 
 /*------------------------------------------------------------------------*/
 
-// Not yet tried and larger clauses are tried first.
-
-struct clause_covered_or_smaller {
-  bool operator () (const Clause * a, const Clause * b) {
-    if (a->covered && !b->covered) return true;
-    if (!a->covered && b->covered) return false;
-    return a->size < b->size;
+// Not yet tried clauses are tried first, then those with fewer resolution
+// candidates on one of their literals and then larger clauses.
+
+struct cover_candidate_later {
+  bool operator () (const CoverCandidate & a, const CoverCandidate & b) {
+    const Clause * c = a.clause, * d = b.clause;
+    if (c->covered && !d->covered) return true;
+    if (!c->covered && d->covered) return false;
+    if (a.resolvents > b.resolvents) return true;
+    if (a.resolvents < b.resolvents) return false;
+    return c->size < d->size;
   }
 };
 
@@ -475,8 +634,20 @@ int64_t Internal::cover_round () {
     }
   }
 
-  stable_sort (schedule.begin (), schedule.end (),
-    clause_covered_or_smaller ());
+  {
+    vector<CoverCandidate> candidates;
+    candidates.reserve (schedule.size ());
+    for (const auto & c : schedule) {
+      size_t resolvents = clauses.size ();
+      for (const auto & lit : *c)
+        resolvents = min (resolvents, occs (-lit).size ());
+      candidates.push_back ({ c, resolvents });
+    }
+    stable_sort (candidates.begin (), candidates.end (),
+      cover_candidate_later ());
+    for (size_t i = 0; i < candidates.size (); i++)
+      schedule[i] = candidates[i].clause;
+  }
 
 #ifndef QUIET
   const size_t scheduled = schedule.size ();
@@ -496,6 +667,12 @@ int64_t Internal::cover_round () {
     stable_sort (os.begin (), os.end (), clause_smaller_size ());
   }
 
+  if (opts.covercache) {
+    coveror.offsets.resize (2*vsize);
+    coveror.stamps.resize (2*vsize, 0);
+    coveror.closed.resize (vsize, false);
+  }
+
   // This is the main loop of trying to do CCE of candidate clauses.
   //
   int64_t covered = 0;
@@ -35,7 +35,21 @@ int Internal::next_decision_variable_with_best_score () {
   return res;
 }
 
+// Same for learning rate based branching (see 'lrb.cpp').
+//
+int Internal::next_decision_variable_with_best_lrb () {
+  int res = 0;
+  for (;;) {
+    res = lrbs.front ();
+    if (!val (res)) break;
+    (void) lrbs.pop_front ();
+  }
+  LOG ("next LRB decision variable %d with score %g", res, ltab[res]);
+  return res;
+}
+
 int Internal::next_decision_variable () {
+  if (use_lrb ()) return next_decision_variable_with_best_lrb ();
   if (use_scores ()) return next_decision_variable_with_best_score ();
   else               return next_decision_variable_on_queue ();
 }
@@ -135,6 +149,7 @@ int Internal::decide () {
     }
   } else {
     stats.decisions++;
+    if (use_lrb ()) stats.lrbdecisions++;
     int idx = next_decision_variable ();
     const bool target = (opts.target > 1 || (stable && opts.target));
     int decision = decide_phase (idx, target);
@@ -10,183 +10,340 @@ namespace CaDiCaL {
 
 #define TRAVERSED UINT_MAX              // mark completely traversed
 
-struct DFS {
-  unsigned idx;                         // depth first search index
-  unsigned min;                         // minimum reachable index
-  DFS () : idx (0), min (0) { }
-};
+// A new SCC has to contain a binary clause added since the last round, as
+// otherwise the SCC would have been found and substituted already (except
+// for frozen literals, which are never substituted).  Thus it is enough to
+// start depth first searches at literals marked 'decompose', which is done
+// in 'mark_added' for literals in new or shrunken binary clauses and when
+// variables are completely molten.  Initially all variables are marked.
+
+/*------------------------------------------------------------------------*/
+
+// This performs Tarjan's algorithm with an explicit stack starting at
+// 'root' and sets the representatives 'reprs' of all literals reached.
+// Since it only reads watches and only writes 'dfs' and 'reprs' entries
+// of reachable literals, searches in different weakly connected
+// components of the binary implication graph can run in parallel.  If a
+// literal and its negation end up in the same SCC the search stops and
+// that literal is saved as 'inconsistent'.
+
+void Internal::decompose_search (Decomposer & decomposer, int root,
+                                 DFS * dfs, int * reprs)
+{
+  vector<int> & work = decomposer.work;
+  vector<int> & scc = decomposer.scc;
+
+  if (dfs[vlit (root)].min == TRAVERSED) return;        // skip traversed
+  LOG ("new dfs search starting at root %d", root);
+  assert (work.empty ());
+  assert (scc.empty ());
+  work.push_back (root);
+  while (!decomposer.inconsistent && !work.empty ()) {
+    int parent = work.back ();
+    DFS & parent_dfs = dfs[vlit (parent)];
+    if (parent_dfs.min == TRAVERSED) {                  // skip traversed
+      assert (reprs [vlit (parent)]);
+      work.pop_back ();
+    } else {
+      assert (!reprs [vlit (parent)]);
 
-// This performs one round of Tarjan's algorithm, e.g., equivalent literal
-// detection and substitution, on the whole formula.  We might want to
-// repeat it since its application might produce new binary clauses or
-// units.  Such units might even result in an empty clause.
+      // Go over all implied literals, thus need to iterate over all
+      // binary watched clauses with the negation of 'parent'.
 
-bool Internal::decompose_round () {
+      Watches & ws = watches (-parent);
 
-  if (!opts.decompose) return false;
-  if (unsat) return false;
-  if (terminated_asynchronously ()) return false;
+      // Two cases: Either the node has never been visited before, i.e.,
+      // it's depth first search index is zero, then perform the
+      // 'pre-fix' work before visiting it's children.  Otherwise all
+      // it's children and nodes reachable from those children have been
+      // visited and their minimum reachable depth first search index
+      // has been computed.  This second case is the 'post-fix' work.
 
-  assert (!level);
+      if (parent_dfs.idx) {                             // post-fix
 
-  START_SIMPLIFIER (decompose, DECOMP);
+        work.pop_back ();                               // 'parent' done
 
-  stats.decompositions++;
+        // Get the minimum reachable depth first search index reachable
+        // from the children of 'parent'.
 
-  const size_t size_dfs = 2*(1 + (size_t) max_var);
-  DFS * dfs = new DFS[size_dfs];
-  int * reprs = new int[size_dfs];
-  clear_n (reprs, size_dfs);
+        unsigned new_min = parent_dfs.min;
 
-  int non_trivial_sccs = 0, substituted = 0;
-#ifndef QUIET
-  int before = active ();
-#endif
-  unsigned dfs_idx = 0;
+        for (const auto & w : ws) {
+          if (!w.binary ()) continue;
+          const int child = w.blit;
+          if (!active (child)) continue;
+          const DFS & child_dfs = dfs[vlit (child)];
+          if (new_min > child_dfs.min) new_min = child_dfs.min;
+        }
 
-  vector<int> work;                     // depth first search working stack
-  vector<int> scc;                      // collects members of one SCC
+        LOG ("post-fix work dfs search %d index %u reaches minimum %u",
+          parent, parent_dfs.idx, new_min);
+
+        if (parent_dfs.idx == new_min) {                // entry to SCC
+
+          // All nodes on the 'scc' stack after and including 'parent'
+          // are in the same SCC.  Their representative is computed as
+          // the smallest literal (index-wise) in the SCC.  If the SCC
+          // contains both a literal and its negation, then the formula
+          // becomes unsatisfiable.
+
+          int other, size = 0, repr = parent;
+          assert (!scc.empty ());
+          size_t j = scc.size ();
+          do {
+            assert (j > 0);
+            other = scc[--j];
+            if (other == -parent) {
+              LOG ("both %d and %d in one SCC", parent, -parent);
+              decomposer.inconsistent = parent;
+            } else {
+              if (abs (other) < abs (repr)) repr = other;
+              size++;
+            }
+          } while (!decomposer.inconsistent && other != parent);
 
-  // The binary implication graph might have disconnected components and
-  // thus we have in general to start several depth first searches.
+          if (!decomposer.inconsistent) {
+
+            LOG ("SCC of representative %d of size %d", repr, size);
+
+            do {
+              assert (!scc.empty ());
+              other = scc.back ();
+              scc.pop_back ();
+              dfs[vlit (other)].min = TRAVERSED;
+              if (frozen (other)) {
+                reprs[vlit (other) ] = other;
+              } else {
+                reprs[vlit (other)] = repr;
+                if (other != repr) {
+                  decomposer.substituted++;
+                  LOG ("literal %d in SCC of %d", other, repr);
+                }
+              }
+            } while (other != parent);
+
+            if (size > 1) decomposer.non_trivial_sccs++;
+          }
 
-  for (auto root_idx : vars) {
-    if (unsat) break;
-    if (!active (root_idx)) continue;
-    for (int root_sign = -1; !unsat && root_sign <= 1; root_sign += 2) {
-      int root = root_sign * root_idx;
-      if (dfs[vlit (root)].min == TRAVERSED) continue;  // skip traversed
-      LOG ("new dfs search starting at root %d", root);
-      assert (work.empty ());
-      assert (scc.empty ());
-      work.push_back (root);
-      while (!unsat && !work.empty ()) {
-        int parent = work.back ();
-        DFS & parent_dfs = dfs[vlit (parent)];
-        if (parent_dfs.min == TRAVERSED) {              // skip traversed
-          assert (reprs [vlit (parent)]);
-          work.pop_back ();
         } else {
-          assert (!reprs [vlit (parent)]);
 
-          // Go over all implied literals, thus need to iterate over all
-          // binary watched clauses with the negation of 'parent'.
+          // Current node 'parent' is in a non-trivial SCC but is not
+          // the entry point of the SCC in this depth first search, so
+          // keep it on the SCC stack until the entry point is reached.
 
-          Watches & ws = watches (-parent);
+          parent_dfs.min = new_min;
+        }
 
-          // Two cases: Either the node has never been visited before, i.e.,
-          // it's depth first search index is zero, then perform the
-          // 'pre-fix' work before visiting it's children.  Otherwise all
-          // it's children and nodes reachable from those children have been
-          // visited and their minimum reachable depth first search index
-          // has been computed.  This second case is the 'post-fix' work.
+      } else {                                          // pre-fix
 
-          if (parent_dfs.idx) {                         // post-fix
+        unsigned & dfs_idx = decomposer.dfs_idx;
+        dfs_idx++;
+        assert (dfs_idx < TRAVERSED);
+        parent_dfs.idx = parent_dfs.min = dfs_idx;
+        scc.push_back (parent);
 
-            work.pop_back ();                           // 'parent' done
+        LOG ("pre-fix work dfs search %d index %u", parent, dfs_idx);
 
-            // Get the minimum reachable depth first search index reachable
-            // from the children of 'parent'.
+        // Now traverse all the children in the binary implication
+        // graph but keep 'parent' on the stack for 'post-fix' work.
 
-            unsigned new_min = parent_dfs.min;
+        for (const auto & w : ws) {
+          if (!w.binary ()) continue;
+          const int child = w.blit;
+          if (!active (child)) continue;
+          const DFS & child_dfs = dfs[vlit (child)];
+          if (child_dfs.idx) continue;
+          work.push_back (child);
+        }
+      }
+    }
+  }
+  work.clear ();
+  scc.clear ();
+}
 
-            for (const auto & w : ws) {
-              if (!w.binary ()) continue;
-              const int child = w.blit;
-              if (!active (child)) continue;
-              const DFS & child_dfs = dfs[vlit (child)];
-              if (new_min > child_dfs.min) new_min = child_dfs.min;
-            }
+/*------------------------------------------------------------------------*/
+
+// With 'opts.decomposethreads > 1' the roots are distributed over the
+// workers by weakly connected components of the binary implication graph.
+// Only the components containing roots are traversed (following binary
+// watches in both directions), since the searches never leave them.
+// Larger components are assigned first, each to the worker with the least
+// number of literals so far.  Returns the number of workers used.
+
+unsigned Internal::decompose_distribute (vector<Decomposer> & decomposers,
+                                         const vector<int> & roots)
+{
+  const size_t size = 2*(1 + (size_t) max_var);
+  vector<int> component (size, 0);
+  vector<int> count (1, 0);                     // literals per component
+  vector<int> work;
+
+  for (const auto & root : roots) {
+    if (component[vlit (root)]) continue;
+    const int c = count.size ();
+    int literals = 0;
+    component[vlit (root)] = c;
+    work.push_back (root);
+    while (!work.empty ()) {
+      const int lit = work.back ();
+      work.pop_back ();
+      literals++;
+
+      // Implied literals are found in the watches of '-lit' and literals
+      // implying 'lit' as negated blocking literals in those of 'lit'.
+
+      for (int sign = -1; sign <= 1; sign += 2) {
+        for (const auto & w : watches (sign * lit)) {
+          if (!w.binary ()) continue;
+          if (!active (w.blit)) continue;
+          const int other = -sign * w.blit;
+          int & d = component[vlit (other)];
+          if (d) continue;
+          d = c;
+          work.push_back (other);
+        }
+      }
+    }
+    count.push_back (literals);
+  }
 
-            LOG ("post-fix work dfs search %d index %u reaches minimum %u",
-              parent, parent_dfs.idx, new_min);
+  vector<int> components;
+  for (size_t c = 1; c < count.size (); c++)
+    components.push_back (c);
+
+  stable_sort (components.begin (), components.end (),
+    [&] (int a, int b) { return count[a] > count[b]; });
+
+  const unsigned threads = min ((size_t) decomposers.size (),
+                                components.size ());
+  vector<int64_t> load (threads, 0);
+  vector<unsigned> worker (count.size (), 0);
+  for (const auto & c : components) {
+    unsigned best = 0;
+    for (unsigned i = 1; i < threads; i++)
+      if (load[i] < load[best]) best = i;
+    load[best] += count[c];
+    worker[c] = best;
+  }
 
-            if (parent_dfs.idx == new_min) {            // entry to SCC
+  for (const auto & root : roots) {
+    const int c = component[vlit (root)];
+    decomposers[worker[c]].roots.push_back (root);
+  }
 
-              // All nodes on the 'scc' stack after and including 'parent'
-              // are in the same SCC.  Their representative is computed as
-              // the smallest literal (index-wise) in the SCC.  If the SCC
-              // contains both a literal and its negation, then the formula
-              // becomes unsatisfiable.
+  PHASE ("decompose", stats.decompositions,
+    "%zd weakly connected components with roots on %u workers",
+    components.size (), threads);
 
-              int other, size = 0, repr = parent;
-              assert (!scc.empty ());
-              size_t j = scc.size ();
-              do {
-                assert (j > 0);
-                other = scc[--j];
-                if (other == -parent) {
-                  LOG ("both %d and %d in one SCC", parent, -parent);
-                  assign_unit (parent);
-                  learn_empty_clause ();
-                } else {
-                  if (abs (other) < abs (repr)) repr = other;
-                  size++;
-                }
-              } while (!unsat && other != parent);
-
-              if (!unsat) {
-
-                LOG ("SCC of representative %d of size %d", repr, size);
-
-                do {
-                  assert (!scc.empty ());
-                  other = scc.back ();
-                  scc.pop_back ();
-                  dfs[vlit (other)].min = TRAVERSED;
-                  if (frozen (other)) {
-                    reprs[vlit (other) ] = other;
-                  } else {
-                    reprs[vlit (other)] = repr;
-                    if (other != repr) {
-                      substituted++;
-                      LOG ("literal %d in SCC of %d", other, repr);
-                    }
-                  }
-                } while (other != parent);
-
-                if (size > 1) non_trivial_sccs++;
-              }
+  return threads;
+}
 
-            } else {
+/*------------------------------------------------------------------------*/
 
-              // Current node 'parent' is in a non-trivial SCC but is not
-              // the entry point of the SCC in this depth first search, so
-              // keep it on the SCC stack until the entry point is reached.
+// This performs one round of Tarjan's algorithm, e.g., equivalent literal
+// detection and substitution, on the part of the formula touched since the
+// last round.  We might want to repeat it since its application might
+// produce new binary clauses or units.  Such units might even result in an
+// empty clause.
 
-              parent_dfs.min = new_min;
-            }
+bool Internal::decompose_round () {
 
-          } else {                                      // pre-fix
+  if (!opts.decompose) return false;
+  if (unsat) return false;
+  if (terminated_asynchronously ()) return false;
 
-            dfs_idx++;
-            assert (dfs_idx < TRAVERSED);
-            parent_dfs.idx = parent_dfs.min = dfs_idx;
-            scc.push_back (parent);
+  assert (!level);
+
+  START_SIMPLIFIER (decompose, DECOMP);
 
-            LOG ("pre-fix work dfs search %d index %u", parent, dfs_idx);
+  stats.decompositions++;
 
-            // Now traverse all the children in the binary implication
-            // graph but keep 'parent' on the stack for 'post-fix' work.
+  const size_t size_dfs = 2*(1 + (size_t) max_var);
+  DFS * dfs = new DFS[size_dfs];
+  int * reprs = new int[size_dfs];
+  clear_n (reprs, size_dfs);
 
-            for (const auto & w : ws) {
-              if (!w.binary ()) continue;
-              const int child = w.blit;
-              if (!active (child)) continue;
-              const DFS & child_dfs = dfs[vlit (child)];
-              if (child_dfs.idx) continue;
-              work.push_back (child);
-            }
-          }
-        }
-      }
+  int non_trivial_sccs = 0, substituted = 0;
+#ifndef QUIET
+  int before = active ();
+#endif
+
+  // The binary implication graph might have disconnected components and
+  // thus we have in general to start several depth first searches, but
+  // only from literals touched since the last round.
+
+  vector<int> roots;
+  for (auto idx : vars) {
+    if (!active (idx)) continue;
+    Flags & f = flags (idx);
+    if (!f.decompose) continue;
+    f.decompose = false;
+    roots.push_back (-idx);
+    roots.push_back (idx);
+  }
+
+  PHASE ("decompose", stats.decompositions,
+    "starting depth first searches at %zd roots %.0f%%",
+    roots.size (), percent (roots.size (), 2.0*before));
+
+  vector<Decomposer> decomposers (opts.decomposethreads);
+  unsigned threads = 1;
+  if (decomposers.size () > 1 && roots.size () > 1)
+    threads = decompose_distribute (decomposers, roots);
+  else decomposers[0].roots.swap (roots);
+  erase_vector (roots);
+
+  if (threads > 1)
+    run_in_parallel (threads, [&] (unsigned thread) {
+      Decomposer & decomposer = decomposers[thread];
+      for (const auto & root : decomposer.roots)
+        if (!decomposer.inconsistent)
+          decompose_search (decomposer, root, dfs, reprs);
+    });
+  else {
+    Decomposer & decomposer = decomposers[0];
+    for (const auto & root : decomposer.roots)
+      if (!decomposer.inconsistent)
+        decompose_search (decomposer, root, dfs, reprs);
+  }
+
+  for (unsigned i = 0; !unsat && i < threads; i++) {
+    const Decomposer & decomposer = decomposers[i];
+    if (decomposer.inconsistent) {
+      assign_unit (decomposer.inconsistent);
+      learn_empty_clause ();
     }
+    non_trivial_sccs += decomposer.non_trivial_sccs;
+    substituted += decomposer.substituted;
   }
 
-  erase_vector (work);
-  erase_vector (scc);
+  erase_vector (decomposers);
   delete [] dfs;
 
+  // Without substituted literals no clause changes, thus neither clauses
+  // nor watches have to be traversed again.
+
+  if (!substituted) {
+    PHASE ("decompose", stats.decompositions,
+      "%d non-trivial sccs, no literal substituted", non_trivial_sccs);
+    delete [] reprs;
+    report ('d', !opts.reportall && !unsat);
+    STOP_SIMPLIFIER (decompose, DECOMP);
+    return unsat;
+  }
+
+  // Literals not reached are their own representative.
+
+  for (auto idx : vars) {
+    if (!active (idx)) continue;
+    for (int sign = -1; sign <= 1; sign += 2) {
+      const int lit = sign * idx;
+      int & repr = reprs[vlit (lit)];
+      if (!repr) repr = lit;
+    }
+  }
+
   // Only keep the representatives 'repr' mapping.
 
   PHASE ("decompose",
@@ -310,8 +467,6 @@ bool Internal::decompose_round () {
     replaced, percent (replaced, clauses_size),
     garbage, percent (garbage, replaced));
 
-  erase_vector (scc);
-
   // Propagate found units.
 
   if (!unsat && propagated < trail.size () && !propagate ()) {
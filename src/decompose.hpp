@@ -0,0 +1,33 @@
+#ifndef _decompose_hpp_INCLUDED
+#define _decompose_hpp_INCLUDED
+
+#include <vector>
+
+namespace CaDiCaL {
+
+struct DFS {
+  unsigned idx;                         // depth first search index
+  unsigned min;                         // minimum reachable index
+  DFS () : idx (0), min (0) { }
+};
+
+// Roots of depth first searches in the same weakly connected component of
+// the binary implication graph are given to the same 'Decomposer', which
+// then only needs its own stacks and counters (see 'decompose.cpp').
+
+struct Decomposer {
+  std::vector<int> roots;               // start depth first search here
+  std::vector<int> work;                // depth first search working stack
+  std::vector<int> scc;                 // collects members of one SCC
+  unsigned dfs_idx;                     // last depth first search index
+  int non_trivial_sccs;
+  int substituted;
+  int inconsistent;                     // in the same SCC as its negation
+  Decomposer () :
+    dfs_idx (0), non_trivial_sccs (0), substituted (0), inconsistent (0)
+  { }
+};
+
+}
+
+#endif
@@ -136,4 +136,116 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
   report ('2', !opts.reportall && !(subsumed + units));
 }
 
+/*------------------------------------------------------------------------*/
+
+// Duplicated clauses with more than two literals are not found by the scan
+// over watches above.  They might stem from the input or are learned
+// repeatedly (particularly with delayed propagation).  Subsumption would
+// find them eventually, but only for clauses scheduled there and with
+// much more effort.  Instead we sort all larger clauses by an order
+// independent hash of their literals and size and compare only clauses
+// with the same hash and size.  If an irredundant clause has duplicates we
+// keep it and otherwise the redundant one with the smallest glue.
+
+struct DuplicateCandidate {
+  uint64_t hash;
+  Clause * clause;
+};
+
+struct duplicate_candidate_less {
+  bool operator () (const DuplicateCandidate & a,
+                    const DuplicateCandidate & b) const {
+    if (a.hash < b.hash) return true;
+    if (a.hash > b.hash) return false;
+    return a.clause->size < b.clause->size;
+  }
+};
+
+// Returns 'true' if 'd' should be kept instead of the duplicate 'c'.
+
+static bool keep_duplicate_instead (Clause * c, Clause * d) {
+  if (!c->redundant) return false;
+  if (!d->redundant) return true;
+  return d->glue < c->glue;
+}
+
+void Internal::mark_duplicated_clauses_as_garbage () {
+
+  if (!opts.deduplicate) return;
+  if (!opts.deduplicatelong) return;
+  if (unsat) return;
+  if (terminated_asynchronously ()) return;
+
+  START_SIMPLIFIER (deduplicate, DEDUP);
+
+  assert (!level);
+
+  vector<DuplicateCandidate> candidates;
+  for (const auto & c : clauses) {
+    if (c->garbage) continue;
+    if (c->size == 2) continue;
+    uint64_t hash = 0;
+    for (const auto & lit : *c)
+      hash += lookup_hash_literal (lit);
+    candidates.push_back (DuplicateCandidate { hash, c });
+  }
+
+  sort (candidates.begin (), candidates.end (),
+    duplicate_candidate_less ());
+
+  int64_t duplicated = 0;
+
+  const auto end = candidates.end ();
+  auto i = candidates.begin ();
+  while (i != end) {
+
+    // Find the range '[i,j)' of candidates with same hash and size.
+
+    auto j = i + 1;
+    while (j != end && j->hash == i->hash &&
+           j->clause->size == i->clause->size)
+      j++;
+
+    for (auto k = i; k + 1 < j; k++) {
+
+      Clause * c = k->clause;
+      if (c->garbage) continue;
+      mark (c);
+
+      for (auto l = k + 1; l != j; l++) {
+        Clause * d = l->clause;
+        if (d->garbage) continue;
+        bool same = true;
+        for (const auto & lit : *d)
+          if (marked (lit) <= 0) { same = false; break; }
+        if (!same) continue;
+        LOG (d, "found duplicate");
+        duplicated++;
+        stats.subsumed++;
+        stats.deduplong++;
+        if (keep_duplicate_instead (c, d)) {
+          LOG (c, "mark garbage duplicated");
+          mark_garbage (c);
+          break;
+        }
+        LOG (d, "mark garbage duplicated");
+        mark_garbage (d);
+      }
+
+      unmark (c);
+    }
+
+    i = j;
+  }
+
+  PHASE ("deduplicate", stats.deduplications,
+    "removed %" PRId64 " duplicated clauses out of %zd %.0f%%",
+    duplicated, candidates.size (),
+    percent (duplicated, candidates.size ()));
+
+  erase_vector (candidates);
+
+  STOP_SIMPLIFIER (deduplicate, DEDUP);
+}
+
 }
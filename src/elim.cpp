@@ -87,6 +87,7 @@ Internal::elim_update_added_clause (Eliminator & eliminator, Clause * c) {
     const int idx = abs (lit);
     if (schedule.contains (idx)) schedule.update (idx);
   }
+  lookup_insert (eliminator.lookup, c);
 }
 
 void Internal::elim_update_removed_lit (Eliminator & eliminator, int lit) {
@@ -118,6 +119,23 @@ Internal::elim_update_removed_clause (Eliminator & eliminator,
 
 /*------------------------------------------------------------------------*/
 
+// The hash table for finding gate clauses contains all irredundant clauses
+// with three up to the maximum size of XOR gate clauses (unassigned)
+// literals.  It is kept up-to-date for added, strengthened and propagated
+// clauses and rebuilt after garbage collection.
+
+void Internal::elim_init_lookup (Eliminator & eliminator) {
+  Lookup & lookup = eliminator.lookup;
+  if (!opts.elimsubst || (!opts.elimites && !opts.elimxors)) return;
+  const int max_size = opts.elimxors ? opts.elimxorlim + 1 : 3;
+  init_lookup (lookup, 3, max_size);
+  for (const auto & c : clauses)
+    if (!c->redundant)
+      lookup_insert (lookup, c);
+}
+
+/*------------------------------------------------------------------------*/
+
 // Since we do not have watches we have to do our own unit propagation
 // during elimination as soon we find a unit clause.  This finds new units
 // and also marks clauses satisfied by those units as garbage immediately.
@@ -155,7 +173,7 @@ void Internal::elim_propagate (Eliminator & eliminator, int root) {
         LOG ("new unit %d during elimination propagation of %d", unit, lit);
         assign_unit (unit);
         work.push_back (unit);
-      }
+      } else lookup_insert (eliminator.lookup, c);      // lost '-lit'
     }
     if (unsat) break;
     const Occs & ps = occs (lit);
@@ -366,6 +384,20 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
 
 /*------------------------------------------------------------------------*/
 
+// With gate clauses only resolvents between a gate and a non-gate clause
+// are needed.  Resolvents among syntactic gate clauses are tautological,
+// while those of a semantic definition have to be kept.
+
+inline bool
+Internal::elim_skip_resolvent (Eliminator & eliminator,
+                               Clause * c, Clause * d)
+{
+  if (c->gate != d->gate) return false;
+  return !c->gate || !eliminator.definition;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Check whether the number of non-tautological resolvents on 'pivot' is
 // smaller or equal to the number of clauses with 'pivot' or '-pivot'.  This
 // is the main criteria of bounded variable elimination.  As a side effect
@@ -400,35 +432,110 @@ Internal::elim_resolvents_are_bounded (Eliminator & eliminator, int pivot)
   // bound on non-tautological resolvents is not hit and the size of the
   // generated resolvents does not exceed the resolvent clause size limit.
 
+  // The resolvents are only counted but not generated.  The literals of
+  // the positive occurrence are stamped once for all negative occurrences
+  // and then only the literals of the negative occurrence are traversed
+  // to find clashing and new literals.  For the rare cases where the
+  // resolution in 'resolve_clauses' has side effects (an antecedent is
+  // satisfied, the resolvent is a unit or the empty clause, or it allows
+  // on-the-fly self-subsuming resolution) we fall back to calling it.
+
+  vector<unsigned> & stamps = eliminator.litstamps;
+  const size_t needed = 2 * (size_t) (max_var + 1);
+  if (stamps.size () < needed) stamps.resize (needed, 0);
+
   int64_t resolvents = 0;          // Non-tautological resolvents.
 
   for (const auto & c : ps) {
     assert (!c->redundant);
     if (c->garbage) continue;
+
+    unsigned stamp = 0;            // Zero if 'c' needs to be (re)stamped.
+    bool satisfied = false;        // First antecedent 'c' satisfied.
+    int marked = 0;                // Stamped literals of 'c'.
+
     for (const auto & d : ns) {
       assert (!d->redundant);
       if (d->garbage) continue;
-      if (substitute && c->gate == d->gate) continue;
+      if (substitute && elim_skip_resolvent (eliminator, c, d)) continue;
       stats.elimrestried++;
-      if (resolve_clauses (eliminator, c, pivot, d, true)) {
-        resolvents++;
-        int size = clause.size ();
-        clause.clear ();
-        LOG ("now at least %" PRId64
-          " non-tautological resolvents on pivot %d",
-          resolvents, pivot);
-        if (size > opts.elimclslim) {
-          LOG ("resolvent size %d too big after %" PRId64
-            " resolvents on %d",
-            size, resolvents, pivot);
-          return false;
+
+      if (c->garbage) { stats.elimres++; continue; }
+
+      if (!stamp) {
+        if (!++eliminator.litstamp) {
+          fill (stamps.begin (), stamps.end (), 0);
+          eliminator.litstamp = 1;
         }
-        if (resolvents > bound) {
-          LOG ("too many non-tautological resolvents on %d", pivot);
-          return false;
+        stamp = eliminator.litstamp;
+        satisfied = false;
+        marked = 0;
+        for (const auto & lit : *c) {
+          if (lit == pivot) continue;
+          const signed char tmp = val (lit);
+          if (tmp > 0) { satisfied = true; break; }
+          if (tmp < 0) continue;
+          stamps[vlit (lit)] = stamp;
+          marked++;
         }
-      } else if (unsat) return false;
-      else if (val (pivot)) return false;
+      }
+
+      bool fallback = satisfied, tautological = false;
+      int added = 0, common = 0;
+
+      if (!fallback)
+        for (const auto & lit : *d) {
+          if (lit == -pivot) continue;
+          const signed char tmp = val (lit);
+          if (tmp > 0) { fallback = true; break; }
+          if (tmp < 0 || tautological) continue;
+          const unsigned u = vlit (lit);
+          if (stamps[u] == stamp) common++;
+          else if (stamps[u^1] == stamp) tautological = true;
+          else added++;
+        }
+
+      const int size = marked + added;
+      if (!fallback && !tautological)
+        fallback = (size < 2 || !added || common == marked);
+
+      if (fallback) {
+        const bool resolved = resolve_clauses (eliminator, c, pivot, d, true);
+        stamp = 0;
+        if (resolved) {
+          resolvents++;
+          const bool too_big = (int) clause.size () > opts.elimclslim;
+          clause.clear ();
+          if (too_big) return false;
+          if (resolvents > bound) return false;
+        } else if (unsat) return false;
+        else if (val (pivot)) return false;
+        continue;
+      }
+
+      stats.elimres++;
+      stats.elimcounted++;
+
+      if (tautological) {
+        LOG ("resolvent tautological");
+        continue;
+      }
+
+      resolvents++;
+      LOG ("now at least %" PRId64
+        " non-tautological resolvents on pivot %d",
+        resolvents, pivot);
+
+      if (size > opts.elimclslim) {
+        LOG ("resolvent size %d too big after %" PRId64
+          " resolvents on %d",
+          size, resolvents, pivot);
+        return false;
+      }
+      if (resolvents > bound) {
+        LOG ("too many non-tautological resolvents on %d", pivot);
+        return false;
+      }
     }
   }
 
@@ -467,7 +574,7 @@ Internal::elim_add_resolvents (Eliminator & eliminator, int pivot) {
     for (auto & d : ns) {
       if (unsat) break;
       if (d->garbage) continue;
-      if (substitute && c->gate == d->gate) continue;
+      if (substitute && elim_skip_resolvent (eliminator, c, d)) continue;
       if (!resolve_clauses (eliminator, c, pivot, d, false)) continue;
       Clause * r = new_resolved_irredundant_clause ();
       elim_update_added_clause (eliminator, r);
@@ -574,9 +681,18 @@ Internal::try_to_eliminate_variable (Eliminator & eliminator, int pivot) {
   if (pos) find_gate_clauses (eliminator, pivot);
 
   if (!unsat && !val (pivot)) {
-    if (elim_resolvents_are_bounded (eliminator, pivot)) {
+    ElimCandidate * candidate = elim_precomputed (eliminator, pivot);
+    bool bounded;
+    if (candidate) {
+      stats.elimtried++;
+      stats.elimres += candidate->resolutions;
+      stats.elimrestried += candidate->resolutions;
+      bounded = candidate->bounded > 0;
+    } else bounded = elim_resolvents_are_bounded (eliminator, pivot);
+    if (bounded) {
       LOG ("number of resolvents on %d are bounded", pivot);
-      elim_add_resolvents (eliminator, pivot);
+      if (candidate) elim_add_precomputed_resolvents (eliminator, *candidate);
+      else elim_add_resolvents (eliminator, pivot);
       if (!unsat) mark_eliminated_clauses_as_garbage (eliminator, pivot);
       if (active (pivot)) mark_eliminated (pivot);
     } else LOG ("too many resolvents on %d so not eliminated", pivot);
@@ -588,6 +704,220 @@ Internal::try_to_eliminate_variable (Eliminator & eliminator, int pivot) {
 
 /*------------------------------------------------------------------------*/
 
+// With 'opts.elimthreads > 1' variables are taken from the schedule in
+// batches.  Those candidates which do not share any variable in their
+// clauses with the previous candidates of the batch ('independent') are
+// checked by worker threads, which count and collect resolvents without
+// changing the formula.  Other candidates are deferred to a later batch.
+// Then the candidates are tried in order as before, but can reuse the
+// result of the workers, since eliminating an independent candidate (or
+// subsuming and strengthening clauses with its resolvents) never touches
+// clauses of the other candidates.  Only units (which are propagated
+// globally) and garbage collection invalidate the precomputed results.
+// Workers also give up if the sequential check would change the formula,
+// i.e., on satisfied clauses, units and on-the-fly self-subsumption, and
+// if gate clauses are found the candidate is checked sequentially too.
+
+void Internal::elim_schedule_batch (Eliminator & eliminator) {
+
+  ElimSchedule & schedule = eliminator.schedule;
+  vector<ElimCandidate> & candidates = eliminator.candidates;
+  candidates.clear ();
+  eliminator.next = 0;
+
+  const unsigned threads = opts.elimthreads;
+  if (eliminator.marks.size () != threads) {
+    eliminator.marks.resize (threads);
+    for (auto & marks : eliminator.marks)
+      marks.resize (max_var + 1, 0);
+  }
+  if ((size_t) max_var >= eliminator.stamps.size ())
+    eliminator.stamps.resize (max_var + 1, 0);
+  eliminator.stamp++;
+
+  vector<int> deferred;
+  const size_t size = 1024;     // number of scheduled variables per batch
+
+  while (candidates.size () + deferred.size () < size &&
+         !schedule.empty ()) {
+
+    int idx = schedule.front ();
+    schedule.pop_front ();
+
+    ElimCandidate candidate (idx);
+    if (active (idx)) {
+      const size_t pos = flush_occs (idx);
+      const size_t neg = flush_occs (-idx);
+      if (pos > neg) candidate.pivot = -idx;
+      if (pos && neg && max (pos, neg) <= (size_t) opts.elimocclim) {
+        Occs & ps = occs (candidate.pivot);
+        stable_sort (ps.begin (), ps.end (), clause_smaller_size ());
+        Occs & ns = occs (-candidate.pivot);
+        stable_sort (ns.begin (), ns.end (), clause_smaller_size ());
+        bool independent = true;
+        for (int sign = -1; independent && sign <= 1; sign += 2)
+          for (const auto & c : occs (sign * idx)) {
+            for (const auto & lit : *c)
+              if (eliminator.stamps[abs (lit)] == eliminator.stamp)
+                { independent = false; break; }
+            if (!independent) break;
+          }
+        if (!independent) {
+          LOG ("deferring dependent elimination candidate %d", idx);
+          deferred.push_back (idx);
+          continue;
+        }
+        for (int sign = -1; sign <= 1; sign += 2)
+          for (const auto & c : occs (sign * idx))
+            for (const auto & lit : *c)
+              eliminator.stamps[abs (lit)] = eliminator.stamp;
+        candidate.independent = true;
+      }
+    }
+    candidates.push_back (candidate);
+  }
+
+  for (const auto & idx : deferred)
+    schedule.push_back (idx);
+
+  LOG ("scheduled batch of %zd elimination candidates (%zd deferred)",
+    candidates.size (), deferred.size ());
+
+  eliminator.fixed = stats.all.fixed;
+  run_in_parallel (threads, [&] (unsigned thread) {
+    elim_worker (eliminator, thread);
+  });
+}
+
+// Same as the sequential 'elim_resolvents_are_bounded' (without gates) for
+// every 'threads' independent candidate of the batch.  The resolvents are
+// generated in the same way as by 'resolve_clauses' but with thread local
+// marks.  Workers must not change anything except their candidates.
+
+void Internal::elim_worker (Eliminator & eliminator, unsigned thread) {
+
+  vector<signed char> & marks = eliminator.marks[thread];
+  vector<ElimCandidate> & candidates = eliminator.candidates;
+  const size_t threads = eliminator.marks.size ();
+
+  for (size_t k = thread; k < candidates.size (); k += threads) {
+
+    ElimCandidate & candidate = candidates[k];
+    if (!candidate.independent) continue;
+
+    vector<int> & resolvents = candidate.resolvents;
+    const int pivot = candidate.pivot;
+    const Occs & ps = occs (pivot);
+    const Occs & ns = occs (-pivot);
+    candidate.pos = ps.size ();
+    candidate.neg = ns.size ();
+    const int64_t bound = ps.size () + ns.size () + lim.elimbound;
+    int64_t count = 0;
+
+    signed char bounded = 1;
+
+    for (const auto & e : ps) {
+      for (const auto & f : ns) {
+
+        candidate.resolutions++;
+
+        Clause * c = e, * d = f;
+        int p = pivot;
+        if (c->size > d->size) { p = -p; swap (c, d); }
+
+        const size_t start = resolvents.size ();
+        bool satisfied = false, tautological = false;
+        int s = 0, t = 0;
+
+        for (const auto & lit : *c) {
+          if (lit == p) { s++; continue; }
+          const signed char tmp = val (lit);
+          if (tmp > 0) { satisfied = true; break; }
+          if (tmp < 0) continue;
+          marks[abs (lit)] = sign (lit);
+          resolvents.push_back (lit);
+          s++;
+        }
+
+        if (!satisfied)
+          for (const auto & lit : *d) {
+            if (lit == -p) { t++; continue; }
+            const signed char tmp = val (lit);
+            if (tmp > 0) { satisfied = true; break; }
+            if (tmp < 0) continue;
+            const int mark = sign (lit) * marks[abs (lit)];
+            if (mark < 0) { tautological = true; break; }
+            if (!mark) resolvents.push_back (lit);
+            t++;
+          }
+
+        for (const auto & lit : *c)
+          marks[abs (lit)] = 0;
+
+        const int size = resolvents.size () - start;
+
+        if (satisfied || (!tautological &&
+            (size < 2 || s > size || t > size)))
+          { bounded = 0; goto DONE; }
+
+        if (tautological) { resolvents.resize (start); continue; }
+
+        resolvents.push_back (0);
+        count++;
+
+        if (size > opts.elimclslim || count > bound)
+          { bounded = -1; goto DONE; }
+      }
+    }
+
+  DONE:
+
+    candidate.bounded = bounded;
+    if (bounded <= 0) erase_vector (resolvents);
+  }
+}
+
+// Return the candidate with precomputed result if it is still valid.
+
+ElimCandidate *
+Internal::elim_precomputed (Eliminator & eliminator, int pivot) {
+  ElimCandidate * candidate = eliminator.candidate;
+  if (!candidate) return 0;
+  if (!candidate->bounded) return 0;
+  if (candidate->pivot != pivot) return 0;
+  if (!eliminator.gates.empty ()) return 0;
+  if (eliminator.fixed != stats.all.fixed) return 0;
+  const Occs & ps = occs (pivot);
+  const Occs & ns = occs (-pivot);
+  if (ps.size () != candidate->pos) return 0;
+  if (ns.size () != candidate->neg) return 0;
+  for (const auto & c : ps) if (c->garbage) return 0;
+  for (const auto & d : ns) if (d->garbage) return 0;
+  LOG ("using precomputed %s resolvents on %d",
+    candidate->bounded > 0 ? "bounded" : "too many", pivot);
+  return candidate;
+}
+
+// Same as 'elim_add_resolvents' but with precomputed resolvents.
+
+void Internal::elim_add_precomputed_resolvents (Eliminator & eliminator,
+                                                ElimCandidate & candidate)
+{
+  LOG ("adding all precomputed resolvents on %d", candidate.pivot);
+  stats.elimres += candidate.resolutions;
+  assert (clause.empty ());
+  for (const auto & lit : candidate.resolvents) {
+    if (lit) { clause.push_back (lit); continue; }
+    Clause * r = new_resolved_irredundant_clause ();
+    elim_update_added_clause (eliminator, r);
+    eliminator.enqueue (r);
+    clause.clear ();
+  }
+  erase_vector (candidate.resolvents);
+}
+
+/*------------------------------------------------------------------------*/
+
 void
 Internal::mark_redundant_clauses_with_eliminated_variables_as_garbage () {
   for (const auto & c : clauses) {
@@ -700,6 +1030,8 @@ int Internal::elim_round (bool & completed) {
         if (active (lit))
           occs (lit).push_back (c);
 
+  elim_init_lookup (eliminator);
+
 #ifndef QUIET
   const int64_t old_resolutions = stats.elimres;
 #endif
@@ -718,21 +1050,48 @@ int Internal::elim_round (bool & completed) {
 #ifndef QUIET
   int64_t tried = 0;
 #endif
+  const bool parallel = opts.elimthreads > 1;
+  vector<ElimCandidate> & candidates = eliminator.candidates;
+
   while (!unsat &&
          !terminated_asynchronously () &&
          stats.elimres <= resolution_limit &&
-         !schedule.empty ()) {
-    int idx = schedule.front ();
-    schedule.pop_front ();
+         (!schedule.empty () || eliminator.next < candidates.size ())) {
+    int idx;
+    if (parallel) {
+      if (eliminator.next == candidates.size ())
+        elim_schedule_batch (eliminator);
+      if (candidates.empty ()) break;
+      ElimCandidate & candidate = candidates[eliminator.next++];
+      idx = abs (candidate.pivot);
+      if (schedule.contains (idx)) continue;    // rescheduled meanwhile
+      eliminator.candidate = &candidate;
+    } else {
+      idx = schedule.front ();
+      schedule.pop_front ();
+    }
     flags (idx).elim = false;
     try_to_eliminate_variable (eliminator, idx);
+    eliminator.candidate = 0;
 #ifndef QUIET
     tried++;
 #endif
     if (stats.garbage <= garbage_limit) continue;
     mark_redundant_clauses_with_eliminated_variables_as_garbage ();
     garbage_collection ();
+    erase_vector (eliminator.sigs);
+    elim_init_lookup (eliminator);      // clauses have been moved
+    for (size_t i = eliminator.next; i < candidates.size (); i++)
+      candidates[i].bounded = 0;        // clauses have been moved
+  }
+
+  // Put back candidates of an interrupted batch.
+  //
+  while (eliminator.next < candidates.size ()) {
+    const int idx = abs (candidates[eliminator.next++].pivot);
+    if (!schedule.contains (idx)) schedule.push_back (idx);
   }
+  erase_vector (candidates);
 
   // If the schedule is empty all variables have been tried (even
   // rescheduled ones).  Otherwise asynchronous termination happened or we
@@ -755,6 +1114,7 @@ int Internal::elim_round (bool & completed) {
       opts.instantiate)
     collect_instantiation_candidates (instantiator);
 
+  reset_lookup (eliminator.lookup);
   reset_occs ();
   reset_noccs ();
 
@@ -826,6 +1186,8 @@ void Internal::increase_elimination_bound () {
 void Internal::elim (bool update_limits) {
 
   if (unsat) return;
+  reset_amos ();
+  reset_xors ();
   if (level) backtrack ();
   if (!propagate ()) { learn_empty_clause (); return; }
 
@@ -2,6 +2,8 @@
 #define _elim_hpp_INCLUDED
 
 #include "heap.hpp"     // Alphabetically after 'elim.hpp'.
+#include "lookup.hpp"   // Alphabetically after 'elim.hpp'.
+#include "occs.hpp"     // Alphabetically after 'elim.hpp'.
 
 namespace CaDiCaL {
 
@@ -15,12 +17,30 @@ struct elim_more {
 
 typedef heap<elim_more> ElimSchedule;
 
+// Candidate variable of a batch in parallel elimination rounds.  Worker
+// threads determine whether the number of resolvents is bounded and also
+// collect the resolvents for candidates with disjoint neighborhoods.
+
+struct ElimCandidate {
+  int pivot;                    // phase with less occurrences
+  bool independent;             // disjoint from other candidates
+  signed char bounded;          // bounded (1), too many (-1), unknown (0)
+  size_t pos, neg;              // number of occurrences seen by worker
+  int64_t resolutions;          // tried resolutions until decision
+  vector<int> resolvents;       // zero terminated resolvents
+  ElimCandidate (int p) :
+    pivot (p), independent (false), bounded (0),
+    pos (0), neg (0), resolutions (0) { }
+};
+
 struct Eliminator {
 
   Internal * internal;
   ElimSchedule schedule;
 
-  Eliminator (Internal * i) : internal (i), schedule (elim_more (i)) { }
+  Eliminator (Internal * i) :
+    internal (i), schedule (elim_more (i)), definition (false),
+    litstamp (0), candidate (0), next (0), fixed (0), stamp (0) { }
   ~Eliminator ();
 
   queue<Clause*> backward;
@@ -29,7 +49,32 @@ struct Eliminator {
   void enqueue (Clause *);
 
   vector<Clause *> gates;
+  bool definition;              // gates form a semantic definition
   vector<int> marked;
+
+  // Small irredundant clauses for finding gate clauses.
+  //
+  Lookup lookup;
+
+  // Lazily computed clause signatures for backward subsumption.
+  //
+  vector<SigOccs> sigs;
+  uint64_t signature (int lit, size_t pos, Clause *);
+
+  // Stamped literals of the first antecedent while counting resolvents.
+  //
+  vector<unsigned> litstamps;
+  unsigned litstamp;
+
+  // Batch of candidates for 'opts.elimthreads > 1'.
+  //
+  vector<ElimCandidate> candidates;
+  ElimCandidate * candidate;            // currently tried candidate
+  size_t next;                          // next candidate to try
+  int fixed;                            // units when batch was checked
+  vector<vector<signed char>> marks;    // thread local marks
+  vector<unsigned> stamps;              // variables in neighborhoods
+  unsigned stamp;                       // of current batch
 };
 
 }
@@ -13,13 +13,15 @@ struct Flags {        // Variable flags.
   bool removable : 1;    // can be removed in 'minimize'
   bool shrinkable : 1; // can be removed in 'shrink'
 
-  // These three variable flags are used to schedule clauses in subsumption
-  // ('subsume'), variables in bounded variable elimination ('elim') and in
-  // hyper ternary resolution ('ternary').
+  // These four variable flags are used to schedule clauses in subsumption
+  // ('subsume'), variables in bounded variable elimination ('elim'), in
+  // hyper ternary resolution ('ternary') and roots in equivalent literal
+  // detection ('decompose').
   //
   bool elim      : 1; // removed since last 'elim' round (*)
   bool subsume   : 1; // added since last 'subsume' round (*)
   bool ternary   : 1; // added in ternary clause since last 'ternary' (*)
+  bool decompose : 1; // added in binary clause since last 'decompose' (*)
 
   // These literal flags are used by blocked clause elimination ('block').
   //
@@ -46,7 +48,7 @@ struct Flags {        // Variable flags.
   //
   Flags () {
     seen = keep = poison = removable = shrinkable = false;
-    subsume = elim = ternary = true;
+    subsume = elim = ternary = decompose = true;
     block = 3u;
     skip = assumed = failed = 0;
     status = UNUSED;
@@ -67,6 +69,7 @@ struct Flags {        // Variable flags.
     dst.elim = elim;
     dst.subsume = subsume;
     dst.ternary = ternary;
+    dst.decompose = decompose;
     dst.block = block;
   }
 };
@@ -288,27 +288,12 @@ bool Internal::get_ternary_clause (Clause * d, int & a, int & b, int & c)
   return found == 3;
 }
 
-// This function checks whether 'd' exists as ternary clause.
-
-bool Internal::match_ternary_clause (Clause * d, int a, int b, int c) {
-  if (d->garbage) return false;
-  int found = 0;
-  for (const auto & lit : *d) {
-    if (val (lit)) continue;
-    if (a != lit && b != lit && c != lit) return false;
-    found++;
-  }
-  return found == 3;
-}
+// Check whether the ternary clause exists (see 'lookup.cpp').
 
 Clause *
-Internal::find_ternary_clause (int a, int b, int c) {
-  if (occs (b).size () > occs (c).size ()) swap (b, c);
-  if (occs (a).size () > occs (b).size ()) swap (a, b);
-  for (auto d : occs (a))
-    if (match_ternary_clause (d, a, b, c))
-      return d;
-  return 0;
+Internal::find_ternary_clause (Eliminator & eliminator, int a, int b, int c) {
+  const int lits[3] = { a, b, c };
+  return lookup_clause (eliminator.lookup, lits, 3);
 }
 
 /*------------------------------------------------------------------------*/
@@ -344,9 +329,9 @@ void Internal::find_if_then_else (Eliminator & eliminator, int pivot) {
       if (abs (bi) == abs (cj)) swap (bj, cj);
       if (abs (ci) == abs (cj)) continue;
       if (bi != -bj) continue;
-      Clause * d1 = find_ternary_clause (-pivot, bi, -ci);
+      Clause * d1 = find_ternary_clause (eliminator, -pivot, bi, -ci);
       if (!d1) continue;
-      Clause * d2 = find_ternary_clause (-pivot, bj, -cj);
+      Clause * d2 = find_ternary_clause (eliminator, -pivot, bj, -cj);
       if (!d2) continue;
       LOG (di, "1st if-then-else");
       LOG (dj, "2nd if-then-else");
@@ -386,34 +371,11 @@ bool Internal::get_clause (Clause * c, vector<int> & l) {
   return true;
 }
 
-// Check whether 'c' contains only the literals in 'l'.
+// Check whether a clause with exactly these literals exists.
 
-bool Internal::is_clause (Clause * c, const vector<int> & lits) {
-  if (c->garbage) return false;
-  int size = lits.size ();
-  if (c->size < size) return false;
-  int found = 0;
-  for (const auto & lit : *c) {
-    if (val (lit)) continue;
-    const auto it = find (lits.begin (), lits.end (), lit);
-    if (it == lits.end ()) return false;
-    if (++found > size) return false;
-  }
-  return found == size;
-}
-
-Clause * Internal::find_clause (const vector<int> & lits) {
-  int best = 0;
-  size_t len = 0;
-  for (const auto & lit : lits) {
-    size_t l = occs (lit).size ();
-    if (best && l >= len) continue;
-    len = l, best = lit;
-  }
-  for (auto c : occs (best))
-    if (is_clause (c, lits))
-      return c;
-  return 0;
+Clause *
+Internal::find_clause (Eliminator & eliminator, const vector<int> & lits) {
+  return lookup_clause (eliminator.lookup, lits.data (), lits.size ());
 }
 
 void Internal::find_xor_gate (Eliminator & eliminator, int pivot) {
@@ -453,7 +415,7 @@ void Internal::find_xor_gate (Eliminator & eliminator, int pivot) {
         if ((prev & bit) != (signs & bit))
           lits[j] = lit = -lit;
       }
-      Clause * e = find_clause (lits);
+      Clause * e = find_clause (eliminator, lits);
       if (!e) break;
       eliminator.gates.push_back (e);
     } while (--needed);
@@ -500,6 +462,187 @@ void Internal::find_xor_gate (Eliminator & eliminator, int pivot) {
 
 /*------------------------------------------------------------------------*/
 
+// Semantic gate detection ('definition mining' as in Kissat).  The pivot
+// is defined by its clauses if the clauses with the pivot and those with
+// its negation, after removing the pivot and its negation, are together
+// unsatisfiable.  Then the clauses in an unsatisfiable core are gate
+// clauses.  This captures for instance definitions through cardinality
+// constraints, which are missed by the syntactic patterns above.  Since
+// the environment of a variable is small, we use a simple DPLL solver
+// with an effort limit ('ticks') and compute a minimal core by trying to
+// drop one clause after the other.
+//
+// Different from syntactic gates the resolvents among the clauses of such
+// a definition are in general not tautological and have to be kept.  Only
+// resolvents among non-gate clauses are redundant.
+
+struct DefinitionSolver {
+
+  vector<vector<int>> clauses;          // over variables '1..vars'
+  vector<bool> active;                  // clauses in current subset
+  vector<signed char> vals;
+  vector<int> trail;
+  int64_t ticks, limit;
+
+  DefinitionSolver (int vars, int64_t l) :
+    vals (vars + 1, 0), ticks (0), limit (l) { }
+
+  signed char val (int lit) const {
+    const signed char tmp = vals[abs (lit)];
+    return lit < 0 ? -tmp : tmp;
+  }
+
+  void assign (int lit) {
+    vals[abs (lit)] = lit < 0 ? -1 : 1;
+    trail.push_back (lit);
+  }
+
+  void backtrack (size_t level) {
+    while (trail.size () > level) {
+      vals[abs (trail.back ())] = 0;
+      trail.pop_back ();
+    }
+  }
+
+  // Naive propagation until fix-point.  Returns 'false' on conflict.
+
+  bool propagate () {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (size_t i = 0; i < clauses.size (); i++) {
+        if (!active[i]) continue;
+        const vector<int> & c = clauses[i];
+        ticks += c.size ();
+        int unit = 0;
+        bool satisfied = false;
+        for (const auto & lit : c) {
+          const signed char tmp = val (lit);
+          if (tmp > 0) { satisfied = true; break; }
+          if (tmp < 0) continue;
+          if (unit) { unit = INT_MIN; break; }
+          unit = lit;
+        }
+        if (satisfied || unit == INT_MIN) continue;
+        if (!unit) return false;
+        assign (unit);
+        changed = true;
+      }
+    }
+    return true;
+  }
+
+  // Returns 10 if satisfiable, 20 if unsatisfiable and 0 if the effort
+  // limit was hit.  All assignments are undone before returning.
+
+  int solve () {
+    if (ticks > limit) return 0;
+    const size_t level = trail.size ();
+    int res = 20;
+    if (propagate ()) {
+      int decision = 0;
+      for (size_t i = 0; !decision && i < clauses.size (); i++)
+        if (active[i])
+          for (const auto & lit : clauses[i])
+            if (!val (lit)) { decision = lit; break; }
+      if (!decision) res = 10;
+      else {
+        const size_t decided = trail.size ();
+        for (int phase = 1; res == 20 && phase >= -1; phase -= 2) {
+          assign (phase * decision);
+          res = solve ();
+          backtrack (decided);
+        }
+      }
+    }
+    backtrack (level);
+    return res;
+  }
+};
+
+void Internal::find_definition (Eliminator & eliminator, int pivot) {
+
+  if (!opts.elimdefs) return;
+
+  assert (opts.elimsubst);
+
+  if (unsat) return;
+  if (val (pivot)) return;
+  if (!eliminator.gates.empty ()) return;
+
+  // Collect the environment of the pivot, i.e., its clauses without the
+  // pivot literal and without root-level falsified literals.
+
+  vector<Clause *> antecedents;
+  vector<int> lits, vars;
+
+  for (int sign = -1; sign <= 1; sign += 2) {
+    const int lit = sign * pivot;
+    for (const auto & c : occs (lit)) {
+      if (c->garbage) continue;
+      bool satisfied = false;
+      for (const auto & other : *c) {
+        if (other == lit) continue;
+        const signed char tmp = val (other);
+        if (tmp > 0) { satisfied = true; break; }
+        if (tmp < 0) continue;
+        vars.push_back (abs (other));
+      }
+      if (satisfied) continue;
+      if ((int) antecedents.size () >= opts.elimdefcls) return;
+      antecedents.push_back (c);
+    }
+  }
+
+  sort (vars.begin (), vars.end ());
+  vars.resize (unique (vars.begin (), vars.end ()) - vars.begin ());
+
+  DefinitionSolver solver (vars.size (), opts.elimdefticks);
+
+  for (const auto & c : antecedents) {
+    lits.clear ();
+    for (const auto & other : *c) {
+      if (abs (other) == abs (pivot)) continue;
+      if (val (other)) continue;
+      const int idx = abs (other);
+      const int local = 1 + (lower_bound (vars.begin (), vars.end (), idx)
+                             - vars.begin ());
+      lits.push_back (other < 0 ? -local : local);
+    }
+    if (lits.empty ()) return;          // leave units to resolution
+    solver.clauses.push_back (lits);
+    solver.active.push_back (true);
+  }
+
+  if (solver.solve () != 20) return;
+
+  // Try to remove each clause from the core.  If the remaining clauses are
+  // still unsatisfiable the clause is not needed.
+
+  for (size_t i = 0; i < solver.clauses.size (); i++) {
+    solver.active[i] = false;
+    if (solver.solve () != 20) solver.active[i] = true;
+  }
+
+  for (size_t i = 0; i < antecedents.size (); i++) {
+    if (!solver.active[i]) continue;
+    Clause * c = antecedents[i];
+    assert (!c->gate);
+    c->gate = true;
+    LOG (c, "contributing");
+    eliminator.gates.push_back (c);
+  }
+
+  LOG ("found definition of %d with %zd clauses after %" PRId64 " ticks",
+    pivot, eliminator.gates.size (), solver.ticks);
+
+  eliminator.definition = true;
+  stats.elimgates++;
+  stats.elimdefs++;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Find a gate for 'pivot'.  If such a gate is found, the gate clauses are
 // marked and pushed on the stack of gates.  Further hyper unary resolution
 // might detect units, which are propagated.  This might assign the pivot or
@@ -519,6 +662,7 @@ void Internal::find_gate_clauses (Eliminator & eliminator, int pivot)
   find_and_gate (eliminator, -pivot);
   find_if_then_else (eliminator, pivot);
   find_xor_gate (eliminator, pivot);
+  find_definition (eliminator, pivot);
 }
 
 void Internal::unmark_gate_clauses (Eliminator & eliminator) {
@@ -528,6 +672,7 @@ void Internal::unmark_gate_clauses (Eliminator & eliminator) {
     c->gate = false;
   }
   eliminator.gates.clear ();
+  eliminator.definition = false;
 }
 
 /*------------------------------------------------------------------------*/
@@ -0,0 +1,647 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Gaussian elimination on XOR constraints encoded in CNF.  An XOR over 'k'
+// variables is encoded by the '2^(k-1)' clauses over these variables which
+// have the same parity of negated literals.  We extract such XORs from
+// short irredundant clauses, split them into connected components over
+// shared variables and then perform Gauss-Jordan elimination on a bit
+// packed matrix for each component.  Rows of the reduced matrix with one
+// variable are units and rows with two variables are equivalences, which
+// are added as binary clauses and then substituted by 'decompose'.  An
+// empty row with right-hand side one shows that the formula is
+// unsatisfiable.
+//
+// Elimination is a root-level inprocessing pass run during 'probe'.  The
+// derived units and binary clauses are implied by the irredundant clauses
+// but in general not by unit propagation on them (they are not 'RUP').  We
+// do not produce a derivation for them and thus skip the pass if a proof
+// is traced, which includes internal checking with 'check'.  For this
+// reason the pass is disabled by default ('gauss').
+//
+// Independently the extracted XORs can also be propagated natively during
+// search ('xors'), which does not need any derivation (see below).  The
+// matrix is not kept though, thus there is no Gaussian elimination during
+// search but only propagation of the individual XOR constraints.
+
+/*------------------------------------------------------------------------*/
+
+struct GaussCandidate {
+  Clause * clause;
+  uint64_t hash;        // hash of sorted variables
+  size_t offset;        // sorted variables in 'Gauss.vars'
+  int size;
+};
+
+struct GaussXor {
+  size_t offset;        // sorted variables in 'Gauss.vars'
+  size_t clauses;       // encoding clauses in 'Gauss.clauses'
+  int size;
+  bool rhs;             // parity of the variables
+};
+
+struct Gauss {
+  vector<int> vars;                     // sorted variables of candidates
+  vector<GaussXor> xors;                // extracted XOR constraints
+  vector<Clause *> clauses;             // encoding clauses of XORs
+  vector<int> units;                    // derived units
+  vector<int> equivs;                   // derived equivalences (pairs)
+  bool inconsistent;                    // derived '0 = 1'
+  Gauss () : inconsistent (false) { }
+};
+
+/*------------------------------------------------------------------------*/
+
+static const uint64_t gauss_nonces[] = {
+  0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull,
+  0x94d049bb133111ebull, 0xd6e8feb86659fd93ull,
+  0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+};
+
+struct gauss_candidate_smaller {
+  const vector<int> & vars;
+  gauss_candidate_smaller (const vector<int> & v) : vars (v) { }
+  bool operator () (const GaussCandidate & a,
+                    const GaussCandidate & b) const {
+    if (a.size < b.size) return true;
+    if (a.size > b.size) return false;
+    if (a.hash < b.hash) return true;
+    if (a.hash > b.hash) return false;
+    const int * p = &vars[a.offset], * q = &vars[b.offset];
+    for (int i = 0; i < a.size; i++)
+      if (p[i] != q[i]) return p[i] < q[i];
+    return false;
+  }
+};
+
+// Find all XORs encoded by clauses of size three up to 'gaussmaxsize'.
+// Clauses over the same set of variables are grouped by sorting them with
+// respect to their sorted variables.  Then each group forms an XOR if one
+// of the two parity classes of negation patterns is complete.
+
+void Internal::gauss_extract (Gauss & gauss) {
+
+  vector<GaussCandidate> candidates;
+  vector<int> & vars = gauss.vars;
+
+  const int maxsize = opts.gaussmaxsize;
+
+  for (const auto & c : clauses) {
+    if (c->garbage) continue;
+    if (c->redundant) continue;
+    if (c->size < 3 || c->size > maxsize) continue;
+    assert (!c->parity);
+    bool assigned = false;
+    for (const auto & lit : *c)
+      if (val (lit)) { assigned = true; break; }
+    if (assigned) continue;
+    const size_t offset = vars.size ();
+    for (const auto & lit : *c)
+      vars.push_back (abs (lit));
+    sort (vars.begin () + offset, vars.end ());
+    uint64_t hash = 0;
+    for (int i = 0; i < c->size; i++)
+      hash += gauss_nonces[i] * (uint64_t) vars[offset + i];
+    GaussCandidate candidate;
+    candidate.clause = c;
+    candidate.hash = hash;
+    candidate.offset = offset;
+    candidate.size = c->size;
+    candidates.push_back (candidate);
+  }
+
+  sort (candidates.begin (), candidates.end (),
+        gauss_candidate_smaller (vars));
+
+  const auto end = candidates.end ();
+  auto i = candidates.begin ();
+  gauss_candidate_smaller smaller (vars);
+  vector<unsigned> group;               // negation patterns of group
+
+  while (i != end) {
+
+    auto j = i + 1;
+    while (j != end && !smaller (*i, *j)) j++;
+
+    const int size = i->size;
+    const uint64_t needed = (uint64_t) 1 << (size - 1);
+
+    if ((uint64_t) (j - i) >= needed) {
+
+      const int * v = &vars[i->offset];
+
+      // Bit 'p' of 'patterns' is set if there is a clause in which exactly
+      // the variables 'v[k]' with bit 'k' set in 'p' occur negatively.
+
+      uint64_t patterns = 0;
+      for (auto k = i; k != j; k++) {
+        unsigned p = 0;
+        for (const auto & lit : *k->clause) {
+          if (lit > 0) continue;
+          int pos = 0;
+          while (v[pos] != -lit) pos++;
+          p |= 1u << pos;
+        }
+        patterns |= (uint64_t) 1 << p;
+        group.push_back (p);
+      }
+
+      uint64_t even = 0, odd = 0;
+      for (unsigned p = 0; p < (1u << size); p++) {
+        const uint64_t bit = (uint64_t) 1 << p;
+        if (!(patterns & bit)) continue;
+        if (parity (p)) odd++; else even++;
+      }
+
+      // A clause with negation pattern 'p' excludes the assignment with
+      // exactly the variables in 'p' set to true.  Thus all even patterns
+      // exclude all assignments of even parity and vice versa.
+
+      for (int rhs = 0; rhs < 2; rhs++) {
+        if ((rhs ? even : odd) != needed) continue;
+        GaussXor x;
+        x.offset = i->offset;
+        x.clauses = gauss.clauses.size ();
+        x.size = size;
+        x.rhs = rhs;
+        gauss.xors.push_back (x);
+        for (auto k = i; k != j; k++)
+          if (parity (group[k - i]) != rhs)
+            gauss.clauses.push_back (k->clause);
+        LOG (i->clause, "extracted size %d XOR with rhs %d from", size, rhs);
+      }
+      group.clear ();
+    }
+
+    i = j;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static int gauss_find (vector<int> & parent, int col) {
+  int root = col;
+  while (parent[root] != root) root = parent[root];
+  while (parent[col] != root) {
+    int next = parent[col];
+    parent[col] = root;
+    col = next;
+  }
+  return root;
+}
+
+// Split the XORs into connected components and perform Gauss-Jordan
+// elimination on each component with at most 'gaussmaxvars' variables.
+
+void Internal::gauss_eliminate (Gauss & gauss) {
+
+  const auto & xors = gauss.xors;
+  const auto & vars = gauss.vars;
+
+  vector<int> column (max_var + 1, -1);
+  vector<int> variable, parent;
+
+  for (const auto & x : xors)
+    for (int i = 0; i < x.size; i++) {
+      const int idx = vars[x.offset + i];
+      if (column[idx] >= 0) continue;
+      column[idx] = variable.size ();
+      parent.push_back (variable.size ());
+      variable.push_back (idx);
+    }
+
+  for (const auto & x : xors) {
+    const int first = gauss_find (parent, column[vars[x.offset]]);
+    for (int i = 1; i < x.size; i++) {
+      const int other = gauss_find (parent, column[vars[x.offset + i]]);
+      if (other != first) parent[other] = first;
+    }
+  }
+
+  // Gather the XORs and columns of each component.
+
+  const size_t columns = variable.size ();
+  vector<vector<size_t>> component_xors (columns);
+  vector<vector<int>> component_columns (columns);
+
+  for (size_t c = 0; c < columns; c++)
+    component_columns[gauss_find (parent, c)].push_back (c);
+  for (size_t k = 0; k < xors.size (); k++) {
+    const int root = gauss_find (parent, column[vars[xors[k].offset]]);
+    component_xors[root].push_back (k);
+  }
+
+  vector<int> local (columns, -1);
+  vector<uint64_t> matrix;
+  vector<char> rhs;
+
+  for (size_t root = 0; root < columns; root++) {
+
+    if (gauss.inconsistent) break;
+
+    const auto & cols = component_columns[root];
+    const auto & rows = component_xors[root];
+    if (rows.empty ()) continue;
+    if ((int) cols.size () > opts.gaussmaxvars) continue;
+
+    const size_t n = cols.size ();
+    const size_t m = rows.size ();
+    const size_t words = (n + 63) / 64;
+
+    for (size_t i = 0; i < n; i++)
+      local[cols[i]] = i;
+
+    matrix.assign (m * words, 0);
+    rhs.assign (m, 0);
+
+    for (size_t r = 0; r < m; r++) {
+      const GaussXor & x = xors[rows[r]];
+      uint64_t * row = &matrix[r * words];
+      for (int i = 0; i < x.size; i++) {
+        const int c = local[column[vars[x.offset + i]]];
+        row[c / 64] |= (uint64_t) 1 << (c % 64);
+      }
+      rhs[r] = x.rhs;
+    }
+
+    stats.gaussxors += m;
+
+    // Gauss-Jordan elimination into reduced row echelon form.
+
+    size_t pivots = 0;
+    for (size_t c = 0; c < n && pivots < m; c++) {
+      const size_t w = c / 64;
+      const uint64_t bit = (uint64_t) 1 << (c % 64);
+      size_t p = pivots;
+      while (p < m && !(matrix[p * words + w] & bit)) p++;
+      if (p == m) continue;
+      if (p != pivots) {
+        swap_ranges (matrix.begin () + p * words,
+                     matrix.begin () + (p + 1) * words,
+                     matrix.begin () + pivots * words);
+        swap (rhs[p], rhs[pivots]);
+      }
+      const uint64_t * pivot = &matrix[pivots * words];
+      for (size_t r = 0; r < m; r++) {
+        if (r == pivots) continue;
+        uint64_t * row = &matrix[r * words];
+        if (!(row[w] & bit)) continue;
+        for (size_t k = 0; k < words; k++)
+          row[k] ^= pivot[k];
+        rhs[r] ^= rhs[pivots];
+      }
+      pivots++;
+    }
+
+    // Rows below the pivots are empty and rows with one or two variables
+    // left are units respectively equivalences.
+
+    for (size_t r = pivots; r < m; r++)
+      if (rhs[r]) {
+        LOG ("Gaussian elimination derived inconsistency");
+        gauss.inconsistent = true;
+        break;
+      }
+
+    for (size_t r = 0; !gauss.inconsistent && r < pivots; r++) {
+      const uint64_t * row = &matrix[r * words];
+      int count = 0, found[2];
+      for (size_t k = 0; count < 3 && k < words; k++) {
+        uint64_t word = row[k];
+        while (word && count < 3) {
+          const int c = k * 64 + __builtin_ctzll (word);
+          if (count < 2) found[count] = variable[cols[c]];
+          count++;
+          word &= word - 1;
+        }
+      }
+      assert (count > 0);
+      if (count == 1) {
+        const int unit = rhs[r] ? found[0] : -found[0];
+        LOG ("Gaussian elimination derived unit %d", unit);
+        gauss.units.push_back (unit);
+      } else if (count == 2) {
+        const int a = found[0];
+        const int b = rhs[r] ? -found[1] : found[1];
+        LOG ("Gaussian elimination derived equivalence %d = %d", a, b);
+        gauss.equivs.push_back (a);
+        gauss.equivs.push_back (b);
+      }
+    }
+
+    for (const auto & c : cols)
+      local[c] = -1;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Assign and propagate derived units and add the derived equivalences as
+// binary clauses.  Returns 'true' if binary clauses were added.
+
+bool Internal::gauss_apply (Gauss & gauss) {
+
+  if (gauss.inconsistent) {
+    learn_empty_clause ();
+    return false;
+  }
+
+  for (const auto & unit : gauss.units) {
+    const signed char tmp = val (unit);
+    if (tmp > 0) continue;
+    if (tmp < 0) {
+      LOG ("derived unit %d already falsified", unit);
+      learn_empty_clause ();
+      return false;
+    }
+    stats.gaussunits++;
+    assign_unit (unit);
+  }
+
+  if (!propagate ()) {
+    LOG ("propagation after Gaussian elimination results in inconsistency");
+    learn_empty_clause ();
+    return false;
+  }
+
+  bool added = false;
+  const auto & equivs = gauss.equivs;
+
+  for (size_t i = 0; i < equivs.size (); i += 2) {
+    const int a = equivs[i], b = equivs[i + 1];
+    if (val (a) || val (b)) continue;
+    assert (clause.empty ());
+    clause.push_back (-a);
+    clause.push_back (b);
+    new_gauss_binary_clause ();
+    clause.clear ();
+    clause.push_back (a);
+    clause.push_back (-b);
+    new_gauss_binary_clause ();
+    clause.clear ();
+    stats.gaussequivs++;
+    added = true;
+  }
+
+  return added;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool Internal::gauss () {
+
+  if (!opts.gauss) return false;
+  if (unsat) return false;
+  if (terminated_asynchronously ()) return false;
+  if (proof) return false;
+
+  // Only run again if new irredundant clauses were added or new units
+  // were found since the last call.
+
+  if (last.gauss.added == stats.added.irredundant &&
+      last.gauss.fixed == stats.all.fixed) return false;
+
+  START_SIMPLIFIER (gauss, GAUSS);
+  stats.gauss++;
+
+  assert (!level);
+
+  Gauss gauss;
+  gauss_extract (gauss);
+
+  bool res = false;
+
+  if (!gauss.xors.empty ()) {
+
+    const int64_t old_xors = stats.gaussxors;
+    const int64_t old_units = stats.gaussunits;
+    const int64_t old_equivs = stats.gaussequivs;
+
+    gauss_eliminate (gauss);
+    res = gauss_apply (gauss);
+
+    const int64_t xors = stats.gaussxors - old_xors;
+    const int64_t units = stats.gaussunits - old_units;
+    const int64_t equivs = stats.gaussequivs - old_equivs;
+
+    PHASE ("gauss", stats.gauss,
+      "eliminated %" PRId64 " XORs deriving %" PRId64 " units "
+      "and %" PRId64 " equivalences", xors, units, equivs);
+
+    report ('x', !opts.reportall && !(unsat + units + equivs));
+  }
+
+  last.gauss.added = stats.added.irredundant;
+  last.gauss.fixed = stats.all.fixed;
+
+  STOP_SIMPLIFIER (gauss, GAUSS);
+
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Native XOR constraints.  An XOR over 'k' variables needs '2^(k-1)'
+// clauses of size 'k' which during search only propagate if all but one
+// of its variables are assigned.  Thus the same XORs as for Gaussian
+// elimination are extracted when search continues on the root-level
+// ('detect_xors'), their clauses are flagged as 'parity' and disconnected
+// from the watch lists and instead the XOR constraint is watched by two of
+// its variables in 'xortab' (see 'propagate_xors').  As with native AMO
+// constraints (see 'amo.cpp') the clauses stay in the clause data base, so
+// simplification procedures and proofs still see them.
+//
+// Each XOR constraint is stored flattened in 'xors' starting at a position
+// which is also used to reference it.  It consists of its size, its
+// right-hand side, the position and number of its clauses in 'xorclauses'
+// followed by its variables of which the first two are watched.
+//
+// Explanations are generated lazily.  An assignment forced by an XOR only
+// gets the pseudo reason 'xor_reason' and we remember the XOR in
+// 'xorreasons'.  Only if conflict analysis needs the reason it is replaced
+// by the clause of the XOR in which all other literals are false.  As this
+// clause is an original clause of the formula, learned clauses remain
+// 'RUP' and no additional proof steps are needed.
+//
+// All simplification procedures drop the XOR constraints ('reset_xors')
+// and reconnect their clauses before they run, again as for AMOs.
+
+Clause Internal::xor_reason;
+
+bool Internal::detecting_xors () {
+  if (!opts.xors) return false;
+  if (level) return false;
+  if (!xors.empty ()) return false;
+  if (last.xors.added != stats.added.irredundant) return true;
+  if (last.xors.fixed != stats.all.fixed) return true;
+  return last.xors.resets != stats.xorresets;
+}
+
+void Internal::detect_xors () {
+
+  assert (!level);
+  assert (watching ());
+  assert (xors.empty ());
+
+  START (xors);
+  stats.xorphases++;
+
+  Gauss gauss;
+  gauss_extract (gauss);
+
+  const size_t extracted = gauss.xors.size ();
+
+  if (extracted) {
+
+    xortab.resize (vsize);
+    xorreasons.resize (vsize);
+
+    for (size_t k = 0; k < extracted; k++) {
+      const GaussXor & x = gauss.xors[k];
+      const size_t begin = x.clauses;
+      const size_t end = k + 1 < extracted ?
+        gauss.xors[k + 1].clauses : gauss.clauses.size ();
+      const unsigned start = xors.size ();
+      xors.push_back (x.size);
+      xors.push_back (x.rhs);
+      xors.push_back (xorclauses.size ());
+      xors.push_back (end - begin);
+      for (int i = 0; i < x.size; i++)
+        xors.push_back (gauss.vars[x.offset + i]);
+      for (size_t i = begin; i != end; i++) {
+        Clause * c = gauss.clauses[i];
+        LOG (c, "XOR clause");
+        c->parity = true;
+        xorclauses.push_back (c);
+        stats.xorclauses++;
+      }
+      xortab[xors[start + 4]].push_back (start);
+      xortab[xors[start + 5]].push_back (start);
+      stats.xors++;
+    }
+
+    // Disconnect the flagged clauses from all watch lists.
+
+    for (const auto & lit : lits) {
+      Watches & ws = watches (lit);
+      const auto end = ws.end ();
+      auto j = ws.begin ();
+      for (auto i = j; i != end; i++) {
+        const Watch & w = *i;
+        if (!w.binary () && w.clause->parity) continue;
+        *j++ = w;
+      }
+      ws.resize (j - ws.begin ());
+    }
+
+    PHASE ("xors", stats.xorphases,
+      "found %zd XOR constraints replacing %zd clauses",
+      extracted, gauss.clauses.size ());
+  }
+
+  last.xors.added = stats.added.irredundant;
+  last.xors.fixed = stats.all.fixed;
+  last.xors.resets = stats.xorresets;
+
+  STOP (xors);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Drop all XOR constraints and reconnect their clauses.  Pending pseudo
+// reasons are explained before.  Since this also happens when leaving
+// search with a non-empty trail, the literals watched in a reconnected
+// clause are unassigned or true ones if possible and otherwise false ones
+// assigned last, which keeps the usual watch invariant.
+
+void Internal::reset_xors () {
+  if (xors.empty ()) return;
+  LOG ("resetting XOR constraints");
+  assert (watching ());
+  for (const auto & lit : trail)
+    if (var (lit).reason == &xor_reason)
+      explain_xor_assignment (lit);
+  for (const auto & idx : scores_bcp) {
+    const int lit = vals_bcp[idx] < 0 ? -idx : idx;
+    if (var (lit).reason == &xor_reason)
+      explain_xor_assignment (lit);
+  }
+  auto better = [this] (int a, int b) {
+    const signed char u = val (a), v = val (b);
+    if (u >= 0) return v < 0;
+    if (v >= 0) return false;
+    return var (a).level > var (b).level;
+  };
+  for (const auto & c : xorclauses) {
+    if (!c) continue;
+    c->parity = false;
+    if (c->garbage) continue;
+    int * literals = c->literals;
+    for (int i = 0; i < 2; i++)
+      for (int k = i + 1; k < c->size; k++)
+        if (better (literals[k], literals[i]))
+          swap (literals[i], literals[k]);
+    watch_clause (c);
+  }
+  erase_vector (xors);
+  erase_vector (xortab);
+  erase_vector (xorclauses);
+  erase_vector (xorreasons);
+  stats.xorresets++;
+}
+
+// Garbage collection removes collected and updates moved clauses of XOR
+// constraints.  Collected clauses are only zeroed to keep the positions.
+
+void Internal::flush_xor_clauses () {
+  for (auto & c : xorclauses) {
+    if (!c) continue;
+    if (c->collect ()) c = 0;
+    else if (c->moved) c = c->copy;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Find the clause of the XOR constraint at 'start' in which all literals
+// except 'implied' are false.  For a conflict 'implied' is zero.  Clauses
+// satisfied on the root-level might have been collected but such a clause
+// can not be the one we are looking for.
+
+Clause * Internal::find_xor_clause (unsigned start, int implied) {
+  const int * x = &xors[start];
+  const auto begin = xorclauses.begin () + x[2];
+  const auto end = begin + x[3];
+  for (auto i = begin; i != end; i++) {
+    Clause * c = *i;
+    if (!c) continue;
+    bool found = true;
+    for (const auto & lit : *c) {
+      if (lit == implied) continue;
+      if (val (lit) < 0) continue;
+      found = false;
+      break;
+    }
+    if (!found) continue;
+    assert (!c->garbage);
+    return c;
+  }
+  assert (false);
+  return 0;
+}
+
+// Replace the pseudo reason of the literal 'lit' assigned by an XOR
+// constraint by the actual clause (see 'explained_reason').
+
+void Internal::explain_xor_assignment (int lit) {
+  Var & v = var (lit);
+  assert (v.reason == &xor_reason);
+  v.reason = find_xor_clause (xorreasons[vidx (lit)], lit);
+  LOG (v.reason, "explaining XOR assignment %d by", lit);
+  stats.xorexpls++;
+}
+
+}
@@ -169,6 +169,32 @@ public:
     check ();
   }
 
+  // Restore the heap property for all elements bottom-up in linear time
+  // (Floyd's algorithm), e.g., after evaluation of 'less' changed for many
+  // elements at once.
+  //
+  void heapify () {
+    for (size_t i = size () / 2; i--; )
+      down (array[i]);
+    check ();
+  }
+
+  // Replace the content of the heap by the given elements in linear time.
+  // This first fills 'array' and 'pos' and then restores the heap property
+  // bottom-up, instead of sifting up each element as in 'push_back'.
+  //
+  template<class Elements> void build (const Elements & elements) {
+    clear ();
+    for (const auto & e : elements) {
+      assert (!contains (e));
+      size_t i = array.size ();
+      assert (i < (size_t) invalid_heap_position);
+      array.push_back (e);
+      index (e) = (unsigned) i;
+    }
+    heapify ();
+  }
+
   void clear () {
     array.clear ();
     pos.clear ();
@@ -22,6 +22,15 @@ Internal::Internal ()
   resetrl_thompson (static_cast<size_t>(RestartMode::NUM_MODES)),
   resetrl_historicalScore (0),
 
+  // Reinforcement learning for restart policies
+  restartpolicy (RestartPolicy::GLUE),
+  restartrl_thompson (static_cast<size_t>(RestartPolicy::NUM_POLICIES)),
+  restartrl_historicalScore (0),
+  restartrl_lbdsum (0),
+  restartrl_prevConflicts (0),
+  restartrl_prevDecisions (0),
+  restartrl_prevPropagations (0),
+
   // All other parameters
   mode (SEARCH),
   unsat (false),
@@ -43,8 +52,11 @@ Internal::Internal ()
   score_inc (1.0),
   scores (this),
   scores_bcp (this),
+  lrb_alpha (0),
+  lrbs (this),
   conflict (0),
   ignore (0),
+  vivifiers { Vivifier (0), Vivifier (2), Vivifier (3) },
   propagated (0),
   propagated2 (0),
   best_assigned (0),
@@ -55,6 +67,7 @@ Internal::Internal ()
   proof (0),
   checker (0),
   tracer (0),
+  walkthread (0),
   opts (this),
 #ifndef QUIET
   profiles (this),
@@ -72,6 +85,7 @@ Internal::Internal ()
 }
 
 Internal::~Internal () {
+  stop_walk_thread ();
   for (const auto & c : clauses)
     delete_clause (c);
   if (proof) delete proof;
@@ -150,6 +164,10 @@ void Internal::enlarge (int new_max_var) {
   enlarge_zero (gtab, new_vsize);
   enlarge_zero (stab, new_vsize);
   enlarge_zero (stab_bcp, new_vsize);
+  if (opts.lrb) {
+    enlarge_zero (ltab, new_vsize);
+    enlarge_only (lrbtab, new_vsize);
+  }
   enlarge_init (ptab, 2*new_vsize, -1);
   enlarge_only (ftab, new_vsize);
   enlarge_vals (vals, new_vsize);
@@ -186,6 +204,7 @@ void Internal::init_vars (int new_max_var) {
   max_var = new_max_var;
   init_queue (old_max_var, new_max_var);
   init_scores (old_max_var, new_max_var);
+  init_lrb (old_max_var, new_max_var);
   int initialized = new_max_var - old_max_var;
   stats.vars += initialized;
   stats.unused += initialized;
@@ -236,9 +255,15 @@ int Internal::cdcl_loop_with_inprocessing () {
     else if (eliminating ()) elim ();        // variable elimination
     else if (compacting ()) compact ();      // collect variables
     else if (conditioning ()) condition ();  // globally blocked clauses
+    else if (detecting_amos ()) detect_amos (); // at-most-one constraints
+    else if (detecting_xors ()) detect_xors (); // XOR constraints
     else res = decide ();                    // next decision
   }
 
+  reset_amos ();                             // reconnect their binaries
+  reset_xors ();                             // and XOR clauses
+  stop_walk_thread ();                       // background local search
+
   // fclose(bcpscorefile);
 
   if (stable) { STOP (stable);   report (']'); }
@@ -386,6 +411,13 @@ void Internal::init_search_limits () {
 
   /*----------------------------------------------------------------------*/
 
+  if (!incremental) {
+    lrb_alpha = 1e-3 * opts.lrbalpha;
+    LOG ("initial LRB step size %g", lrb_alpha);
+  }
+
+  /*----------------------------------------------------------------------*/
+
   // Initialize or reset 'restart' limits in any case.
 
   lim.restart = stats.conflicts + opts.restartint;
@@ -419,6 +451,11 @@ void Internal::init_search_limits () {
     reluctant.enable (opts.reluctant, opts.reluctantmax);
   } else reluctant.disable ();
 
+  if (opts.restartrl) {
+    LOG ("new restart policy Luby sequence period %d", opts.restartrlluby);
+    restartrl_luby.enable (opts.restartrlluby, opts.reluctantmax);
+  } else restartrl_luby.disable ();
+
   /*----------------------------------------------------------------------*/
 
   // Conflict and decision limits.
@@ -4,12 +4,21 @@
 #define PBCP_ORDER_BRANCHING 0
 #define PBCP_ORDER_RANDOM 1
 
-// Solver configuration
+// Solver configuration, which can be overwritten at compile time, e.g.,
+// configuring with 'CXXFLAGS=-DPBCP_ORDER=1' randomizes the delayed BCP order.
+
+#ifndef PBCP_ORDER
 #define PBCP_ORDER PBCP_ORDER_BRANCHING
-#define ENABLE_RESETS false
+#endif
+#ifndef ENABLE_PBCP
 #define ENABLE_PBCP false
+#endif
+#ifndef ENABLE_PBCP_RL
 #define ENABLE_PBCP_RL true
+#endif
+#ifndef ENABLE_PBCP_RANDOM
 #define ENABLE_PBCP_RANDOM false
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -65,6 +74,7 @@ extern "C" {
 #include "config.hpp"
 #include "contract.hpp"
 #include "cover.hpp"
+#include "decompose.hpp"
 #include "elim.hpp"
 #include "ema.hpp"
 #include "external.hpp"
@@ -77,10 +87,13 @@ extern "C" {
 #include "level.hpp"
 #include "limit.hpp"
 #include "logging.hpp"
+#include "lrb.hpp"
+#include "lookup.hpp"
 #include "message.hpp"
 #include "observer.hpp"
 #include "occs.hpp"
 #include "options.hpp"
+#include "parallel.hpp"
 #include "parse.hpp"
 #include "phases.hpp"
 #include "profile.hpp"
@@ -101,6 +114,8 @@ extern "C" {
 #include "var.hpp"
 #include "version.hpp"
 #include "vivify.hpp"
+#include "walkcore.hpp"
+#include "walkthread.hpp"
 #include "watch.hpp"
 
 /*------------------------------------------------------------------------*/
@@ -111,6 +126,8 @@ using namespace std;
 
 struct Coveror;
 struct External;
+struct Subsumer;
+struct Gauss;
 struct Walker;
 
 struct CubesWithStatus {
@@ -136,8 +153,19 @@ struct Internal {
 
   enum class RestartMode {
     RESTART   = 0,
-    RESET     = 1,
-    NUM_MODES = 2,
+    RESET     = 1, // randomize all scores
+    DECAY     = 2, // decay scores towards their mean
+    TOPK      = 3, // randomize only the top scores
+    NOISE     = 4, // perturb scores proportional to activity
+    NUM_MODES = 5,
+  };
+
+  enum class RestartPolicy {
+    GLUE         = 0, // Glucose style EMA of glue
+    LUBY         = 1, // Luby sequence (reluctant doubling)
+    GEOMETRIC    = 2, // MiniSAT style geometric intervals
+    NONE         = 3, // no restarts during segment
+    NUM_POLICIES = 4,
   };
 
   /*----------------------------------------------------------------------*/
@@ -152,15 +180,16 @@ struct Internal {
     DECOMP   = (1<<3),
     DEDUP    = (1<<4),
     ELIM     = (1<<5),
-    LUCKY    = (1<<6),
-    PROBE    = (1<<7),
-    SEARCH   = (1<<8),
-    SIMPLIFY = (1<<9),
-    SUBSUME  = (1<<10),
-    TERNARY  = (1<<11),
-    TRANSRED = (1<<12),
-    VIVIFY   = (1<<13),
-    WALK     = (1<<14),
+    GAUSS    = (1<<6),
+    LUCKY    = (1<<7),
+    PROBE    = (1<<8),
+    SEARCH   = (1<<9),
+    SIMPLIFY = (1<<10),
+    SUBSUME  = (1<<11),
+    TERNARY  = (1<<12),
+    TRANSRED = (1<<13),
+    VIVIFY   = (1<<14),
+    WALK     = (1<<15),
   };
 
   bool in_mode (Mode m) const { return (mode & m) != 0; }
@@ -184,6 +213,15 @@ struct Internal {
   Thompson_var resetrl_thompson;  // Activity reset RL struct
   double resetrl_historicalScore;
 
+  RestartPolicy restartpolicy;    // currently selected restart policy
+  Thompson_var restartrl_thompson; // Restart policy RL struct
+  double restartrl_historicalScore;
+  int64_t restartrl_lbdsum;       // sum of glues in current segment
+  int64_t restartrl_prevConflicts;
+  int64_t restartrl_prevDecisions;
+  int64_t restartrl_prevPropagations;
+  Reluctant restartrl_luby;       // Luby sequence for 'LUBY' policy
+
   int mode;                     // current internal state
   bool unsat;                   // empty clause found or learned
   bool iterating;               // report learned unit ('i' line)
@@ -211,24 +249,40 @@ struct Internal {
   double score_inc;             // current score increment
   ScoreSchedule scores;         // score based decision priority queue
 #if PBCP_ORDER == PBCP_ORDER_BRANCHING
-  ScoreSchedule scores_bcp;     // score based priority queue for priority BCP
+  ScoreScheduleBranching scores_bcp; // decision score based priority BCP
 #else
   ScoreScheduleBCP scores_bcp;  // score based priority queue for priority BCP
 #endif
   vector<double> stab;          // table of variable scores [1,max_var]
   vector<double> stab_bcp;      // table of variable scores [1,max_var]
+  double lrb_alpha;             // current LRB step size
+  LRBSchedule lrbs;             // learning rate based decision queue
+  vector<double> ltab;          // table of LRB scores [1,max_var]
+  vector<LRBVar> lrbtab;        // LRB assignment statistics [1,max_var]
   vector<Var> vtab;             // variable table [1,max_var]
   vector<int> parents;          // parent literals during probing
   vector<Flags> ftab;           // variable and literal flags
   vector<int64_t> btab;         // enqueue time stamps for queue
   vector<int64_t> gtab;         // time stamp table to recompute glue
   vector<Occs> otab;            // table of occurrences for all literals
+  vector<SigOccs> sotab;        // one-watch occurrences with signatures
   vector<int> ptab;             // table for caching probing attempts
   vector<int64_t> ntab;         // number of one-sided occurrences table
   vector<Bins> big;             // binary implication graph
   vector<Watches> wtab;         // table of watches for all literals
+  vector<int> amos;             // zero terminated AMO constraints
+  vector<vector<unsigned>> amotab; // AMO constraints of literals
+  vector<Watches> amobins;      // unwatched AMO binary clauses of literals
+  vector<int> amoreasons;       // AMO literals forcing assignments
+  static Clause amo_reason;     // pseudo reason of AMO assignments
+  vector<int> xors;             // flattened native XOR constraints
+  vector<vector<unsigned>> xortab; // XOR constraints watched by variables
+  vector<Clause *> xorclauses;  // unwatched clauses of XOR constraints
+  vector<unsigned> xorreasons;  // XOR constraints forcing assignments
+  static Clause xor_reason;     // pseudo reason of XOR assignments
   Clause * conflict;            // set in 'propagation', reset in 'analyze'
   Clause * ignore;              // ignored during 'vivify_propagate'
+  Vivifier vivifiers[3];        // persistent schedules of 'vivify'
   size_t propagated;            // next trail position to propagate
   size_t propagated2;           // next binary trail position to propagate
   size_t best_assigned;         // best maximum assigned ever
@@ -245,6 +299,7 @@ struct Internal {
   vector<int> analyzed;         // analyzed literals in 'analyze'
   vector<int> minimized;        // removable or poison in 'minimize'
   vector<int> shrinkable;       // removable or poison in 'shrink'
+  SigOccs eagersigs;            // signatures of recently learned clauses
   Reap reap;                    // radix heap for shrink
 
   vector<int> probes;           // remaining scheduled probes
@@ -257,6 +312,7 @@ struct Internal {
   Proof * proof;                // clausal proof observers if non zero
   Checker * checker;            // online proof checker observing proof
   Tracer * tracer;              // proof to file tracer observing proof
+  WalkThread * walkthread;      // background local search if non zero
   Options opts;                 // run-time options
   Stats stats;                  // statistics
 #ifndef QUIET
@@ -299,6 +355,7 @@ struct Internal {
   void init_queue (int old_max_var, int new_max_var);
 
   void init_scores (int old_max_var, int new_max_var);
+  void init_lrb (int old_max_var, int new_max_var);
 
   void add_original_lit (int lit);
 
@@ -384,6 +441,7 @@ struct Internal {
 
   Bins & bins (int lit)       { return big[vlit (lit)]; }
   Occs & occs (int lit)       { return otab[vlit (lit)]; }
+  SigOccs & sigoccs (int lit) { return sotab[vlit (lit)]; }
   int64_t & noccs (int lit)   { return ntab[vlit (lit)]; }
   Watches & watches (int lit) { return wtab[vlit (lit)]; }
 
@@ -394,6 +452,19 @@ struct Internal {
   void bump_variable_score_inc ();
   void rescale_variable_scores ();
 
+  // Learning rate based branching (LRB) can replace EVSIDS in stable mode
+  // ('lrb & 1') and VMTF in focused mode ('lrb & 2').
+  //
+  bool use_lrb () const { return opts.lrb & (stable ? 1 : 2); }
+  void lrb_unassigned (int idx);
+  void lrb_participated (int idx) { lrbtab[idx].participated++; }
+  void lrb_assigned (int idx) {
+    LRBVar & l = lrbtab[idx];
+    l.assigned = stats.conflicts;
+    l.participated = 0;
+  }
+  void lrb_decay_alpha ();
+
   // Marking variables with a sign (positive or negative).
   //
   signed char marked (int lit) const {
@@ -581,6 +652,8 @@ struct Internal {
   void assign_unit (int lit);
   bool propagate ();
   template <BCPMode m> bool propagate_internal ();
+  template <BCPMode m> void propagate_amos (int lit);
+  template <BCPMode m> void propagate_xors (int lit);
 
   // Priority BCP
   //
@@ -607,13 +680,22 @@ struct Internal {
 
   // Reset restarts
   void reset_scores ();
+  void randomize_scores ();
+  void decay_scores ();
+  void randomize_top_scores ();
+  void perturb_scores ();
   RestartMode update_restart_mode_rl ();
 
+  // Restart policy selection
+  RestartPolicy update_restart_policy_rl ();
+  bool restarting_by_policy ();
+
   // Undo and restart in 'backtrack.cpp'.
   //
   void unassign (int lit);
   void update_target_and_best ();
   void backtrack (int target_level = 0);
+  void backtrack_trail (size_t assigned);
 
   // Minimized learned clauses in 'minimize.cpp'.
   //
@@ -650,6 +732,7 @@ struct Internal {
   //
   bool stabilizing ();
   bool restarting ();
+  bool restarting_by_glue ();
   int reuse_trail ();
   void restart ();
 
@@ -682,6 +765,8 @@ struct Internal {
   int backward_true_satisfiable ();
   int positive_horn_satisfiable ();
   int negative_horn_satisfiable ();
+  int sequential_lucky_phases ();
+  int parallel_lucky_phases ();
 
   // Asynchronous terminating check.
   //
@@ -728,12 +813,21 @@ struct Internal {
   // Set-up occurrence list counters and containers.
   //
   void init_occs ();
+  void init_sigoccs ();
   void init_bins ();
   void init_noccs ();
   void reset_occs ();
+  void reset_sigoccs ();
   void reset_bins ();
   void reset_noccs ();
 
+  // Hash table of small clauses in 'lookup.cpp'.
+  //
+  void init_lookup (Lookup &, int min_size, int max_size);
+  void reset_lookup (Lookup &);
+  void lookup_insert (Lookup &, Clause *);
+  Clause * lookup_clause (Lookup &, const int * lits, int size);
+
   // Operators on watches.
   //
   void init_watches ();
@@ -748,7 +842,11 @@ struct Internal {
   void strengthen_clause (Clause *, int);
   void subsume_clause (Clause * subsuming, Clause * subsumed);
   int subsume_check (Clause * subsuming, Clause * subsumed);
+  uint64_t subsume_signature (Clause *);
   int try_to_subsume_clause (Clause *, vector<Clause*> & shrunken);
+  void subsume_worker (Subsumer &, unsigned thread);
+  void subsume_batch (Subsumer &);
+  int subsume_commit (Subsumer &, size_t, vector<Clause*> & shrunken);
   void reset_subsume_bits ();
   bool subsume_round ();
   void subsume (bool update_limits = true);
@@ -760,14 +858,21 @@ struct Internal {
   void cover_push_extension (int lit, Coveror &);
   bool cover_propagate_asymmetric (int lit, Clause * ignore, Coveror &);
   bool cover_propagate_covered (int lit, Coveror &);
+  size_t cover_closure (int lit, Coveror &);
+  bool cover_propagate_closure (int lit, Coveror &);
   bool cover_clause (Clause * c, Coveror &);
   int64_t cover_round ();
   bool cover ();
 
   // Strengthening through vivification in 'vivify.cpp'.
   //
-  void flush_vivification_schedule (Vivifier &);
-  bool consider_to_vivify_clause (Clause * candidate, bool redundant_mode);
+  void flush_vivification_schedule (vector<Clause *> &);
+  void add_vivification_candidate (Clause *);
+  void prune_vivification_schedule (Vivifier &);
+  void update_vivification_schedule (Vivifier &);
+  void flush_vivification_schedules ();
+  void reset_vivification_schedules ();
+  bool consider_to_vivify_clause (Clause * candidate, int tier);
   void vivify_analyze_redundant (Vivifier &, Clause * start, bool &);
   bool vivify_all_decisions (Clause * candidate, int subsume);
   void vivify_post_process_analysis (Clause * candidate, int subsume);
@@ -776,7 +881,7 @@ struct Internal {
   void vivify_assume (int lit);
   bool vivify_propagate ();
   void vivify_clause (Vivifier &, Clause * candidate);
-  void vivify_round (bool redundant_mode, int64_t delta);
+  void vivify_round (int tier, int64_t delta);
   void vivify ();
 
   // Compacting (shrinking internal variable tables) in 'compact.cpp'
@@ -825,6 +930,14 @@ struct Internal {
     stats.mark.ternary++;
     f.ternary = true;
   }
+  void mark_decompose (int lit) {
+    Flags & f = flags (lit);
+    if (f.decompose) return;
+    LOG ("marking %d as decompose root candidate", abs (lit));
+    stats.mark.decompose++;
+    f.decompose = true;
+  }
+  void mark_decompose (Clause *);
   void mark_added (int lit, int size, bool redundant);
   void mark_added (Clause *);
 
@@ -912,16 +1025,15 @@ struct Internal {
     void find_equivalence(Eliminator &, int pivot);
 
     bool get_ternary_clause(Clause *, int &, int &, int &);
-    bool match_ternary_clause(Clause *, int, int, int);
-    Clause *find_ternary_clause(int, int, int);
+    Clause *find_ternary_clause(Eliminator &, int, int, int);
 
     bool get_clause(Clause *, vector<int> &);
-    bool is_clause(Clause *, const vector<int> &);
-    Clause *find_clause(const vector<int> &);
+    Clause *find_clause(Eliminator &, const vector<int> &);
     void find_xor_gate(Eliminator &, int pivot);
 
     void find_if_then_else(Eliminator &, int pivot);
 
+    void find_definition(Eliminator &, int pivot);
     void find_gate_clauses(Eliminator &, int pivot);
     void unmark_gate_clauses(Eliminator &);
 
@@ -932,17 +1044,23 @@ struct Internal {
     void mark_redundant_clauses_with_eliminated_variables_as_garbage();
     void unmark_binary_literals(Eliminator &);
     bool resolve_clauses(Eliminator &, Clause *, int pivot, Clause *, bool);
+    bool elim_skip_resolvent(Eliminator &, Clause *, Clause *);
     void mark_eliminated_clauses_as_garbage(Eliminator &, int pivot);
     bool elim_resolvents_are_bounded(Eliminator &, int pivot);
     void elim_update_removed_lit(Eliminator &, int lit);
     void elim_update_removed_clause(Eliminator &, Clause *, int except = 0);
     void elim_update_added_clause(Eliminator &, Clause *);
+    void elim_init_lookup(Eliminator &);
     void elim_add_resolvents(Eliminator &, int pivot);
     void elim_backward_clause(Eliminator &, Clause *);
     void elim_backward_clauses(Eliminator &);
     void elim_propagate(Eliminator &, int unit);
     void elim_on_the_fly_self_subsumption(Eliminator &, Clause *, int);
     void try_to_eliminate_variable(Eliminator &, int pivot);
+    void elim_schedule_batch(Eliminator &);
+    void elim_worker(Eliminator &, unsigned thread);
+    ElimCandidate * elim_precomputed(Eliminator &, int pivot);
+    void elim_add_precomputed_resolvents(Eliminator &, ElimCandidate &);
     void increase_elimination_bound();
     int elim_round(bool &completed);
     void elim(bool update_limits = true);
@@ -955,15 +1073,50 @@ struct Internal {
 
     // Hyper ternary resolution.
     //
-    bool ternary_find_binary_clause(int, int);
-    bool ternary_find_ternary_clause(int, int, int);
+    bool ternary_find_binary_clause(Lookup &, int, int);
+    bool ternary_find_ternary_clause(Lookup &, int, int, int);
     Clause *new_hyper_ternary_resolved_clause(bool red);
-    bool hyper_ternary_resolve(Clause *, int, Clause *);
-    void ternary_lit(int pivot, int64_t &steps, int64_t &htrs);
-    void ternary_idx(int idx, int64_t &steps, int64_t &htrs);
+    bool hyper_ternary_resolve(Lookup &, Clause *, int, Clause *);
+    void ternary_lit(Lookup &, int pivot, int64_t &steps, int64_t &htrs);
+    void ternary_idx(Lookup &, int idx, int64_t &steps, int64_t &htrs);
     bool ternary_round(int64_t & steps, int64_t & htrs);
     bool ternary();
 
+    // Native at-most-one constraints in 'amo.cpp'.
+    //
+    bool detecting_amos();
+    unsigned amo_degree(int lit);
+    void detect_amos();
+    void reset_amos();
+    void flush_amo_binaries();
+    Clause *find_amo_binary(int lit, int implied);
+    void explain_amo_assignment(int lit);
+
+    // Reason of the assigned literal 'lit' which replaces the pseudo reasons
+    // of AMO and XOR assignments lazily by an actual clause.  Needs to be
+    // used in conflict analysis instead of accessing 'var (lit).reason'.
+    //
+    Clause *explained_reason(int lit) {
+      Var & v = var (lit);
+      if (v.reason == &amo_reason) explain_amo_assignment (lit);
+      else if (v.reason == &xor_reason) explain_xor_assignment (lit);
+      return v.reason;
+    }
+
+    // Gaussian elimination and native XOR constraints in 'gauss.cpp'.
+    //
+    Clause *new_gauss_binary_clause();
+    void gauss_extract(Gauss &);
+    void gauss_eliminate(Gauss &);
+    bool gauss_apply(Gauss &);
+    bool gauss();
+    bool detecting_xors();
+    void detect_xors();
+    void reset_xors();
+    void flush_xor_clauses();
+    Clause *find_xor_clause(unsigned start, int implied);
+    void explain_xor_assignment(int lit);
+
     // Probing in 'probe.cpp'.
     //
     bool probing();
@@ -972,6 +1125,7 @@ struct Internal {
     void probe_assign_decision(int lit);
     void probe_assign(int lit, int parent);
     void mark_duplicated_binary_clauses_as_garbage();
+    void mark_duplicated_clauses_as_garbage();
     int get_parent_reason_literal(int lit);
     void set_parent_reason_literal(int lit, int reason);
     int probe_dominator(int a, int b);
@@ -982,6 +1136,8 @@ struct Internal {
     void generate_probes();
     void flush_probes();
     int next_probe();
+    int probe_tree_top(int probe);
+    bool probe_tree(int lit, int depth, int64_t limit);
     bool probe_round();
     void probe(bool update_limits = true);
 
@@ -989,15 +1145,25 @@ struct Internal {
     //
     void walk_save_minimum(Walker &);
     Clause *walk_pick_clause(Walker &);
-    unsigned walk_break_value(int lit);
+    unsigned walk_break_value(Walker &, int lit);
     int walk_pick_lit(Walker &, Clause *);
     void walk_flip_lit(Walker &, int lit);
     int walk_round(int64_t limit, bool prev);
     void walk();
 
+    // Background local search thread in 'walkthread.cpp'.
+    //
+    int64_t walk_thread_signature();
+    void start_walk_thread();
+    void stop_walk_thread();
+    bool import_walk_thread_phases();
+
     // Detect strongly connected components in the binary implication graph
     // (BIG) and equivalent literal substitution (ELS) in 'decompose.cpp'.
     //
+    void decompose_search(Decomposer &, int root, DFS *, int * reprs);
+    unsigned decompose_distribute(vector<Decomposer> &,
+                                  const vector<int> & roots);
     bool decompose_round();
     void decompose();
 
@@ -1050,6 +1216,7 @@ struct Internal {
     bool satisfied();
     int next_decision_variable_on_queue();
     int next_decision_variable_with_best_score();
+    int next_decision_variable_with_best_lrb();
     int next_decision_variable();
     int decide_phase(int idx, bool target);
     int likely_phase(int idx);
@@ -1192,6 +1359,7 @@ struct Internal {
     if (ref < UINT_MAX) {
       if (!--ref) {
         LOG ("variable %d completely molten", idx);
+        mark_decompose (idx);
       } else
         LOG ("variable %d melted once but remains frozen %u times",
           lit, ref);
@@ -1337,6 +1505,29 @@ inline bool score_smaller::operator () (unsigned a, unsigned b) {
   return a > b;
 }
 
+inline bool lrb_smaller::operator () (unsigned a, unsigned b) {
+  assert (1 <= a);
+  assert (a <= (unsigned) internal->max_var);
+  assert (1 <= b);
+  assert (b <= (unsigned) internal->max_var);
+  double s = internal->ltab[a];
+  double t = internal->ltab[b];
+
+  if (s < t) return true;
+  if (s > t) return false;
+
+  return a > b;
+}
+
+// The delayed propagation queue ordered by decision heuristic scores uses
+// the LRB scores if 'lrbbcp' is set and EVSIDS scores otherwise.
+
+inline bool score_smaller_branching::operator () (unsigned a, unsigned b) {
+  if (internal->opts.lrb && internal->opts.lrbbcp)
+    return lrb_smaller (internal) (a, b);
+  return score_smaller (internal) (a, b);
+}
+
 inline bool score_smaller_bcp::operator () (unsigned a, unsigned b) {
 
   // Avoid computing twice 'abs' in 'score ()'.
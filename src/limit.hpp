@@ -21,6 +21,8 @@ struct Limit {
   int64_t rephase;         // conflict limit for next 'rephase'
   int64_t report;          // report limit for header
   int64_t restart;         // conflict limit for next 'restart'
+  int64_t restartgeom;     // conflict limit for next geometric restart
+  int64_t restartpolicy;   // conflict limit for next restart policy
   int64_t stabilize;       // conflict limit for next 'stabilize'
   int64_t subsume;         // conflict limit for next 'subsume'
 
@@ -49,6 +51,9 @@ struct Last {
   struct { int64_t propagations, reductions; } probe;
   struct { int64_t conflicts; } reduce, rephase;
   struct { int64_t marked; } ternary;
+  struct { int64_t added, fixed; } gauss;
+  struct { int64_t added, fixed, resets; } amo;
+  struct { int64_t added, fixed, resets; } xors;
   struct { int64_t fixed; } collect;
   Last ();
 };
@@ -56,6 +61,7 @@ struct Last {
 struct Inc {
   int64_t flush;           // flushing interval in terms of conflicts
   int64_t stabilize;       // stabilization interval increment
+  int64_t restartgeom;     // geometric restart interval
   int64_t conflicts;       // next conflict limit if non-negative
   int64_t decisions;       // next decision limit if non-negative
   int64_t preprocessing;   // next preprocessing limit if non-negative
@@ -0,0 +1,98 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+void Internal::init_lookup (Lookup & lookup, int min_size, int max_size) {
+  assert (2 <= min_size);
+  assert (min_size <= max_size);
+  erase_vector (lookup.table);
+  lookup.count = 0;
+  lookup.min_size = min_size;
+  lookup.max_size = max_size;
+}
+
+void Internal::reset_lookup (Lookup & lookup) {
+  erase_vector (lookup.table);
+  lookup.count = 0;
+}
+
+static void enlarge_lookup (Lookup & lookup) {
+  const size_t old_size = lookup.table.size ();
+  const size_t new_size = old_size ? 2 * old_size : 1024;
+  vector<LookupEntry> table (new_size, LookupEntry {0, 0});
+  const size_t mask = new_size - 1;
+  for (const auto & e : lookup.table) {
+    if (!e.clause) continue;
+    size_t pos = e.hash & mask;
+    while (table[pos].clause) pos = (pos + 1) & mask;
+    table[pos] = e;
+  }
+  lookup.table.swap (table);
+}
+
+// Add the clause under its currently unassigned literals if their number
+// is in the range of sizes of the table.  Clauses which are strengthened
+// or lose literals due to new units are just added again.
+
+void Internal::lookup_insert (Lookup & lookup, Clause * c) {
+  if (!lookup.max_size) return;
+  if (c->garbage) return;
+  if (c->size < lookup.min_size) return;
+  uint64_t hash = 0;
+  int size = 0;
+  for (const auto & lit : *c) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) return;
+    if (tmp < 0) continue;
+    if (++size > lookup.max_size) return;
+    hash += lookup_hash_literal (lit);
+  }
+  if (size < lookup.min_size) return;
+  if (2 * (lookup.count + 1) > lookup.table.size ())
+    enlarge_lookup (lookup);
+  const size_t mask = lookup.table.size () - 1;
+  size_t pos = hash & mask;
+  while (lookup.table[pos].clause) pos = (pos + 1) & mask;
+  lookup.table[pos] = LookupEntry {hash, c};
+  lookup.count++;
+}
+
+// Find a non-garbage clause, whose unassigned literals are exactly the
+// given (unassigned and different) literals.
+
+Clause * Internal::lookup_clause (Lookup & lookup,
+                                  const int * lits, int size) {
+  if (lookup.table.empty ()) return 0;
+  stats.lookups++;
+  assert (lookup.min_size <= size);
+  assert (size <= lookup.max_size);
+  uint64_t hash = 0;
+  for (int i = 0; i < size; i++) {
+    assert (!val (lits[i]));
+    hash += lookup_hash_literal (lits[i]);
+  }
+  const size_t mask = lookup.table.size () - 1;
+  for (size_t pos = hash & mask;
+       lookup.table[pos].clause;
+       pos = (pos + 1) & mask) {
+    const LookupEntry & e = lookup.table[pos];
+    if (e.hash != hash) continue;
+    Clause * c = e.clause;
+    if (c->garbage) continue;
+    int found = 0;
+    for (const auto & lit : *c) {
+      if (val (lit)) continue;
+      const int * end = lits + size;
+      if (find (lits, end, lit) == end) { found = -1; break; }
+      found++;
+    }
+    if (found != size) continue;
+    stats.lookuphits++;
+    return c;
+  }
+  return 0;
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef _lookup_hpp_INCLUDED
+#define _lookup_hpp_INCLUDED
+
+#include <vector>
+
+namespace CaDiCaL {
+
+// Hash table of small clauses used to check in constant time whether a
+// clause with exactly the given (unassigned) literals exists.  It replaces
+// linear scans over occurrence lists in hyper ternary resolution and gate
+// detection, which are quadratic for literals with many occurrences.  The
+// hash of a clause is computed from its unassigned literals independent of
+// their order and entries are never removed.  Instead every hit is checked
+// against the current literals of the clause, which makes outdated entries
+// of garbage or strengthened clauses harmless.  See 'lookup.cpp'.
+
+struct Clause;
+using namespace std;
+
+struct LookupEntry {
+  uint64_t hash;
+  Clause * clause;
+};
+
+struct Lookup {
+  vector<LookupEntry> table;    // open addressing with linear probing
+  size_t count;                 // number of entries in 'table'
+  int min_size, max_size;       // range of sizes of stored clauses
+  Lookup () : count (0), min_size (0), max_size (0) { }
+};
+
+// Order independent hash of a set of literals.  Each literal is mixed
+// separately and the results are summed up.  Also used for finding
+// duplicated clauses in 'deduplicate.cpp'.
+
+inline uint64_t lookup_hash_literal (int lit) {
+  uint64_t res = (uint32_t) lit;
+  res *= 0x9e3779b97f4a7c15ull;
+  res ^= res >> 29;
+  res *= 0xbf58476d1ce4e5b9ull;
+  return res ^ (res >> 32);
+}
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// Learning rate based branching (see 'lrb.hpp').  The LRB heap and tables
+// are only maintained if 'opts.lrb' is non-zero, which then is used in
+// stable mode (bit 1) instead of EVSIDS and in focused mode (bit 2)
+// instead of VMTF.  The scores can also be used to order delayed
+// propagation ('opts.lrbbcp').  In contrast to the original paper we do
+// not implement the reason side rate nor the locality extension, since the
+// latter requires to touch all unassigned variables after each conflict.
+
+void Internal::init_lrb (int old_max_var, int new_max_var) {
+  if (!opts.lrb) return;
+  LOG ("initializing LRB scores from %d to %d",
+    old_max_var + 1, new_max_var);
+  for (int i = old_max_var; i < new_max_var; i++)
+    lrbs.push_back (i + 1);
+}
+
+// The learning rate of a variable is only updated if at least one conflict
+// occurred while it was assigned.  Otherwise (and for assignments not made
+// during search, e.g., during probing) the score is left untouched.
+
+void Internal::lrb_unassigned (int idx) {
+  assert (opts.lrb);
+  LRBVar & l = lrbtab[idx];
+  if (l.assigned >= 0) {
+    const int64_t interval = stats.conflicts - l.assigned;
+    if (interval > 0) {
+      const double rate = l.participated / (double) interval;
+      double & s = ltab[idx];
+      s = (1 - lrb_alpha) * s + lrb_alpha * rate;
+      LOG ("new LRB score %g of %d with rate %g", s, idx, rate);
+      if (lrbs.contains (idx)) lrbs.update (idx);
+    }
+    l.assigned = -1;
+  }
+  if (!lrbs.contains (idx)) lrbs.push_back (idx);
+}
+
+// The step size decreases with every conflict until it reaches its minimum.
+
+void Internal::lrb_decay_alpha () {
+  assert (opts.lrb);
+  const double min_alpha = 1e-3 * opts.lrbalphamin;
+  if (lrb_alpha <= min_alpha) return;
+  lrb_alpha -= 1e-6 * opts.lrbalphadec;
+  if (lrb_alpha < min_alpha) lrb_alpha = min_alpha;
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef _lrb_hpp_INCLUDED
+#define _lrb_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+// Learning rate based branching (LRB) as introduced by Liang, Ganesh,
+// Poupart and Czarnecki in their SAT'16 paper.  The score of a variable is
+// an exponential moving average of its 'learning rate', which is the
+// fraction of conflicts it participated in while being assigned.  For each
+// variable we remember the number of conflicts at the time it was assigned
+// and count the conflicts it was analyzed in.  The score is updated when
+// the variable becomes unassigned (see 'lrb.cpp').
+
+struct LRBVar {
+  int64_t assigned;     // conflicts when assigned (negative if invalid)
+  int64_t participated; // analyzed in that many conflicts since assigned
+  LRBVar () : assigned (-1), participated (0) { }
+};
+
+struct lrb_smaller {
+  Internal * internal;
+  lrb_smaller (Internal * i) : internal (i) { }
+  bool operator () (unsigned a, unsigned b);
+};
+
+typedef heap<lrb_smaller> LRBSchedule;
+
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "internal.hpp"
 
+#include <atomic>
+
 namespace CaDiCaL {
 
 // It turns out that even in the competition there are formulas which are
@@ -270,6 +272,280 @@ int Internal::negative_horn_satisfiable () {
 
 /*------------------------------------------------------------------------*/
 
+// The lucky strategies in the order in which they are tried.
+
+static int (Internal::* const lucky_strategies[]) () = {
+  &Internal::trivially_false_satisfiable,
+  &Internal::trivially_true_satisfiable,
+  &Internal::forward_true_satisfiable,
+  &Internal::forward_false_satisfiable,
+  &Internal::backward_false_satisfiable,
+  &Internal::backward_true_satisfiable,
+  &Internal::positive_horn_satisfiable,
+  &Internal::negative_horn_satisfiable,
+};
+
+static const unsigned num_lucky_strategies =
+  sizeof lucky_strategies / sizeof *lucky_strategies;
+
+static double & lucky_time (Stats & stats, unsigned strategy) {
+  switch (strategy) {
+    case 0: return stats.lucky.time.constant.zero;
+    case 1: return stats.lucky.time.constant.one;
+    case 2: return stats.lucky.time.forward.one;
+    case 3: return stats.lucky.time.forward.zero;
+    case 4: return stats.lucky.time.backward.zero;
+    case 5: return stats.lucky.time.backward.one;
+    case 6: return stats.lucky.time.horn.positive;
+    default: return stats.lucky.time.horn.negative;
+  }
+}
+
+int Internal::sequential_lucky_phases () {
+  int res = 0;
+  for (unsigned i = 0; !res && i < num_lucky_strategies; i++) {
+    const double start = absolute_real_time ();
+    res = (this->*lucky_strategies[i]) ();
+    lucky_time (stats, i) += absolute_real_time () - start;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// On large unsatisfiable formulas all of the strategies above fail, each
+// after a full propagation pass over the formula.  With 'luckythreads'
+// larger than one the strategies are therefore first run concurrently on
+// a read-only view of the clauses with thread local assignments.  A
+// strategy which succeeds cancels all later strategies (in the order of
+// the sequential schedule), while earlier ones continue.  Thus the first
+// successful strategy on the view is independent of the number of threads.
+// Only this strategy is then replayed on the actual solver trail in order
+// to produce the model.
+
+// The view skips root level satisfied clauses and removes root level
+// falsified literals.  It contains redundant clauses too, since the
+// sequential strategies propagate over all watched clauses and thus might
+// fail due to a conflict in a redundant clause.  Irredundant clauses come
+// first and are kept in the order of 'clauses', since the Horn strategies
+// traverse only those and in this order.
+
+// For the constant strategies the first success on the view is the same
+// as in sequential mode.  The Horn strategies pick the first literal of
+// the right sign in a clause, but in sequential mode literals of watched
+// clauses are reordered by earlier failed strategies.  Thus a Horn strategy
+// might succeed on the view but fail when replayed (or vice versa), in
+// which case we just fall back to search.
+
+struct LuckyView {
+  int max_var;
+  vector<int> literals;         // zero terminated clauses
+  vector<unsigned> clauses;     // start of clauses in 'literals'
+  size_t irredundant;           // irredundant clauses come first
+  vector<unsigned> starts;      // of occurrence lists of literals
+  vector<unsigned> occs;        // flattened occurrence lists
+  bool inconsistent;            // empty clause in view
+
+  static unsigned code (int lit) { return 2u * abs (lit) + (lit < 0); }
+};
+
+// Thread local assignment of a single strategy.  Since strategies never
+// backtrack, propagation simply counts falsified literals per clause.
+
+struct LuckyWorker {
+
+  const LuckyView & view;
+  const unsigned strategy;
+  atomic<unsigned> & winner;    // first successful strategy
+  atomic<bool> & aborted;       // on asynchronous termination
+  Internal * internal;          // only set for the calling thread
+
+  vector<signed char> values;
+  vector<unsigned> falsified;
+  vector<int> trail;
+  size_t propagated;
+
+  LuckyWorker (const LuckyView & v, unsigned s,
+               atomic<unsigned> & w, atomic<bool> & a, Internal * i) :
+    view (v), strategy (s), winner (w), aborted (a), internal (i),
+    values (v.max_var + 1, 0), falsified (v.clauses.size (), 0),
+    propagated (0) { }
+
+  signed char val (int lit) const {
+    const signed char tmp = values[abs (lit)];
+    return lit < 0 ? -tmp : tmp;
+  }
+
+  bool cancelled () {
+    if (internal && internal->terminated_asynchronously (10))
+      aborted = true;
+    return aborted || winner.load (memory_order_relaxed) < strategy;
+  }
+
+  void assign (int lit) {
+    assert (!val (lit));
+    values[abs (lit)] = lit < 0 ? -1 : 1;
+    trail.push_back (lit);
+  }
+
+  bool propagate () {
+    while (propagated < trail.size ()) {
+      const unsigned code = LuckyView::code (-trail[propagated++]);
+      for (unsigned i = view.starts[code]; i < view.starts[code + 1]; i++) {
+        const unsigned id = view.occs[i];
+        const int * lits = &view.literals[view.clauses[id]];
+        const unsigned count = ++falsified[id];
+        if (lits[count] && lits[count + 1]) continue;
+        int unit = 0;
+        bool satisfied = false;
+        for (const int * p = lits; !satisfied && *p; p++) {
+          const signed char tmp = val (*p);
+          if (tmp > 0) satisfied = true;
+          else if (!tmp) unit = *p;
+        }
+        if (satisfied) continue;
+        if (!unit) return false;
+        assign (unit);
+      }
+    }
+    return true;
+  }
+
+  bool decide (int lit) {
+    if (val (lit)) return true;
+    assign (lit);
+    return propagate ();
+  }
+
+  // Assign all remaining variables to 'sign' in the given direction.
+
+  int constant (int sign, bool forward) {
+    for (int i = 1; i <= view.max_var; i++) {
+      const int idx = forward ? i : view.max_var + 1 - i;
+      if (cancelled ()) return -1;
+      if (!decide (sign * idx)) return 0;
+    }
+    return 10;
+  }
+
+  // The Horn strategies (and the check of the trivial strategies) for
+  // literals of the given 'sign'.
+
+  bool horn (int sign, bool decide_literals) {
+    for (size_t id = 0; id < view.irredundant; id++) {
+      const unsigned start = view.clauses[id];
+      int literal = 0;
+      bool satisfied = false;
+      for (const int * p = &view.literals[start]; *p; p++) {
+        const int lit = *p;
+        const signed char tmp = val (lit);
+        if (tmp > 0) { satisfied = true; break; }
+        if (tmp < 0) continue;
+        if (sign * lit < 0) continue;
+        literal = lit;
+        break;
+      }
+      if (satisfied) continue;
+      if (!literal) return false;
+      if (!decide_literals) continue;
+      if (cancelled ()) return false;
+      if (!decide (literal)) return false;
+    }
+    return true;
+  }
+
+  int run () {
+    if (view.inconsistent) return 0;
+    for (const auto & start : view.clauses)
+      if (!view.literals[start + 1] && !decide (view.literals[start]))
+        return 0;
+    switch (strategy) {
+      case 0: return horn (-1, false) ? constant (-1, true) : 0;
+      case 1: return horn (1, false) ? constant (1, true) : 0;
+      case 2: return constant (1, true);
+      case 3: return constant (-1, true);
+      case 4: return constant (-1, false);
+      case 5: return constant (1, false);
+      case 6: return horn (1, true) ? constant (-1, true) : 0;
+      default: return horn (-1, true) ? constant (1, true) : 0;
+    }
+  }
+};
+
+int Internal::parallel_lucky_phases () {
+
+  LuckyView view;
+  view.max_var = max_var;
+  view.inconsistent = false;
+  view.starts.resize (2 * (size_t) max_var + 3, 0);
+
+  for (int redundant = 0; redundant < 2; redundant++) {
+    if (redundant) view.irredundant = view.clauses.size ();
+    for (const auto & c : clauses) {
+      if (c->garbage || c->redundant != redundant) continue;
+      bool satisfied = false;
+      const size_t old_size = view.literals.size ();
+      for (const auto & lit : *c) {
+        const signed char tmp = val (lit);
+        if (tmp > 0) { satisfied = true; break; }
+        if (tmp < 0) continue;
+        view.literals.push_back (lit);
+      }
+      if (satisfied) { view.literals.resize (old_size); continue; }
+      if (view.literals.size () == old_size) view.inconsistent = true;
+      view.literals.push_back (0);
+      view.clauses.push_back (old_size);
+      for (size_t i = old_size; view.literals[i]; i++)
+        view.starts[LuckyView::code (view.literals[i]) + 1]++;
+    }
+  }
+  for (size_t i = 1; i < view.starts.size (); i++)
+    view.starts[i] += view.starts[i - 1];
+  view.occs.resize (view.starts.back ());
+  {
+    vector<unsigned> next (view.starts.begin (), view.starts.end () - 1);
+    for (unsigned id = 0; id < view.clauses.size (); id++)
+      for (const int * p = &view.literals[view.clauses[id]]; *p; p++)
+        view.occs[next[LuckyView::code (*p)]++] = id;
+  }
+
+  const unsigned threads =
+    min ((unsigned) opts.luckythreads, num_lucky_strategies);
+  atomic<unsigned> winner (num_lucky_strategies);
+  atomic<bool> aborted (false);
+  vector<double> times (num_lucky_strategies, 0);
+
+  run_in_parallel (threads, [&] (unsigned thread) {
+    for (unsigned s = thread; s < num_lucky_strategies; s += threads) {
+      if (aborted || winner.load () < s) break;
+      const double start = absolute_real_time ();
+      LuckyWorker worker (view, s, winner, aborted, thread ? 0 : this);
+      const int res = worker.run ();
+      times[s] = absolute_real_time () - start;
+      if (res != 10) continue;
+      unsigned previous = winner.load ();
+      while (s < previous && !winner.compare_exchange_weak (previous, s))
+        ;
+    }
+  });
+
+  for (unsigned i = 0; i < num_lucky_strategies; i++)
+    lucky_time (stats, i) += times[i];
+
+  if (aborted) return unlucky (-1);
+
+  const unsigned s = winner;
+  if (s == num_lucky_strategies) return 0;
+  LOG ("lucky strategy %u succeeded on view", s);
+
+  const double start = absolute_real_time ();
+  const int res = (this->*lucky_strategies[s]) ();
+  lucky_time (stats, s) += absolute_real_time () - start;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 int Internal::lucky_phases () {
   assert (!level);
   require_mode (SEARCH);
@@ -285,14 +561,9 @@ int Internal::lucky_phases () {
   assert (!searching_lucky_phases);
   searching_lucky_phases = true;
   stats.lucky.tried++;
-  int res       = trivially_false_satisfiable ();
-  if (!res) res = trivially_true_satisfiable ();
-  if (!res) res = forward_true_satisfiable ();
-  if (!res) res = forward_false_satisfiable ();
-  if (!res) res = backward_false_satisfiable ();
-  if (!res) res = backward_true_satisfiable ();
-  if (!res) res = positive_horn_satisfiable ();
-  if (!res) res = negative_horn_satisfiable ();
+  int res;
+  if (opts.luckythreads > 1) res = parallel_lucky_phases ();
+  else res = sequential_lucky_phases ();
   if (res < 0) assert (termination_forced), res = 0;
   if (res == 10) stats.lucky.succeeded++;
   report ('l', !res);
@@ -27,9 +27,10 @@ bool Internal::minimize_literal (int lit, int depth) {
   if (depth > opts.minimizedepth) return false;
   bool res = true;
   assert (v.reason);
-  const const_literal_iterator end = v.reason->end ();
+  const Clause * reason = explained_reason (lit);
+  const const_literal_iterator end = reason->end ();
   const_literal_iterator i;
-  for (i = v.reason->begin (); res && i != end; i++) {
+  for (i = reason->begin (); res && i != end; i++) {
     const int other = *i;
     if (other == lit) continue;
     res = minimize_literal (-other, depth + 1);
@@ -20,6 +20,21 @@ void Internal::reset_occs () {
 
 /*------------------------------------------------------------------------*/
 
+// One-watch occurrence lists with clause signatures used in 'subsume'.
+
+void Internal::init_sigoccs () {
+  if (sotab.size () < 2*vsize)
+    sotab.resize (2*vsize, SigOccs ());
+  LOG ("initialized signature occurrence lists");
+}
+
+void Internal::reset_sigoccs () {
+  erase_vector (sotab);
+  LOG ("reset signature occurrence lists");
+}
+
+/*------------------------------------------------------------------------*/
+
 // One-sided occurrence counter (each literal has its own counter).
 
 void Internal::init_noccs () {
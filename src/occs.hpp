@@ -27,6 +27,20 @@ inline void remove_occs (Occs & os, Clause * c) {
   os.resize (i - os.begin ());
 }
 
+// Occurrences extended by the signature of the clause (see 'clause.hpp'),
+// which allows to filter subsumption candidates without dereferencing the
+// clause.  These are used for the one-watch lists in 'subsume' and for
+// caching signatures during backward subsumption in 'elim'.
+
+struct SigOcc {
+  uint64_t sig;
+  Clause * clause;
+  SigOcc (uint64_t s, Clause * c) : sig (s), clause (c) { }
+  SigOcc () { }
+};
+
+typedef vector<SigOcc> SigOccs;
+
 typedef Occs::iterator occs_iterator;
 typedef Occs::const_iterator const_occs_iterator;
 
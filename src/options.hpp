@@ -19,6 +19,9 @@
 \
 /*      NAME         DEFAULT, LO, HI,O,P,R, USAGE */ \
 \
+OPTION( amo,               0,  0,  1,0,1,1, "native pairwise at-most-one constraints") \
+OPTION( amomaxeff,       1e7,  0,2e9,1,0,1, "maximum AMO detection effort") \
+OPTION( amominsize,        8,  3,1e4,1,0,1, "minimum AMO constraint size") \
 OPTION( arena,             1,  0,  1,0,0,1, "allocate clauses in arena") \
 OPTION( arenacompact,      1,  0,  1,0,0,1, "keep clauses compact") \
 OPTION( arenasort,         1,  0,  1,0,0,1, "sort clauses in arena") \
@@ -28,6 +31,7 @@ OPTION( bcprlbetadecay,  5e2,  0,1e3,1,0,0, "BCP RL thompson beta decay factor p
 OPTION( bcprlscoredecay, 5e2,  0,1e3,1,0,0, "BCP RL score decay factor per mille") \
 OPTION( binary,            1,  0,  1,0,0,1, "use binary proof format") \
 OPTION( block,             0,  0,  1,0,1,1, "blocked clause elimination") \
+OPTION( blockinc,          1,  0,  1,0,0,1, "incremental blocked clause elimination") \
 OPTION( blockmaxclslim,  1e5,  1,2e9,2,0,1, "maximum clause size") \
 OPTION( blockminclslim,    2,  2,2e9,0,0,1, "minimum clause size") \
 OPTION( blockocclim,     1e2,  1,2e9,2,0,1, "occurrence limit") \
@@ -54,8 +58,11 @@ OPTION( conditionint,    1e4,  1,2e9,0,0,1, "initial conflict interval") \
 OPTION( conditionmaxeff, 1e7,  0,2e9,1,0,1, "maximum condition efficiency") \
 OPTION( conditionmaxrat, 100,  1,2e9,1,0,1, "maximum clause variable ratio") \
 OPTION( conditionmineff, 1e6,  0,2e9,1,0,1, "minimum condition efficiency") \
+OPTION( conditionpure,     1,  0,  1,0,0,1, "eliminate pure autarky clauses first") \
 OPTION( conditionreleff, 100,  1,1e5,0,0,1, "relative efficiency per mille") \
 OPTION( cover,             0,  0,  1,0,1,1, "covered clause elimination") \
+OPTION( coveraddlim,     1e3,  1,2e9,2,0,1, "maximum extended clause size") \
+OPTION( covercache,        1,  0,  1,0,0,1, "cache binary implication closures") \
 OPTION( covermaxclslim,  1e5,  1,2e9,2,0,1, "maximum clause size") \
 OPTION( covermaxeff,     1e8,  0,2e9,1,0,1, "maximum cover efficiency") \
 OPTION( coverminclslim,    2,  2,2e9,0,0,1, "minimum clause size") \
@@ -63,7 +70,9 @@ OPTION( covermineff,     1e6,  0,2e9,1,0,1, "minimum cover efficiency") \
 OPTION( coverreleff,       4,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( decompose,         1,  0,  1,0,1,1, "decompose BIG in SCCs and ELS") \
 OPTION( decomposerounds,   2,  1, 16,1,0,1, "number of decompose rounds") \
+OPTION( decomposethreads,  1,  1, 64,0,0,1, "worker threads") \
 OPTION( deduplicate,       1,  0,  1,0,1,1, "remove duplicated binaries") \
+OPTION( deduplicatelong,   1,  0,  1,0,1,1, "remove duplicated long clauses") \
 OPTION( eagersubsume,      1,  0,  1,0,0,1, "subsume recently learned") \
 OPTION( eagersubsumelim,  20,  1,1e3,0,0,1, "limit on subsumed candidates") \
 OPTION( elim,              1,  0,  1,0,1,1, "bounded variable elimination") \
@@ -73,6 +82,9 @@ OPTION( elimbackward,      1,  0,  1,0,0,1, "eager backward subsumption") \
 OPTION( elimboundmax,     16, -1,2e6,1,0,1, "maximum elimination bound") \
 OPTION( elimboundmin,      0, -1,2e6,0,0,1, "minimum elimination bound") \
 OPTION( elimclslim,      1e2,  2,2e9,2,0,1, "resolvent size limit") \
+OPTION( elimdefcls,       32,  2,1e3,1,0,1, "definition mining clause limit") \
+OPTION( elimdefs,          1,  0,  1,0,0,1, "mine semantic definitions") \
+OPTION( elimdefticks,    2e3,  0,2e9,1,0,1, "definition mining effort") \
 OPTION( elimequivs,        1,  0,  1,0,0,1, "find equivalence gates") \
 OPTION( elimineff,       1e7,  0,2e9,1,0,1, "minimum elimination efficiency") \
 OPTION( elimint,         2e3,  1,2e9,0,0,1, "elimination interval") \
@@ -84,6 +96,7 @@ OPTION( elimreleff,      1e3,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( elimrounds,        2,  1,512,1,0,1, "usual number of rounds") \
 OPTION( elimsubst,         1,  0,  1,0,0,1, "elimination by substitution") \
 OPTION( elimsum,           1,  0,1e4,0,0,1, "elimination score sum weight") \
+OPTION( elimthreads,       1,  1, 64,0,0,1, "worker threads") \
 OPTION( elimxorlim,        5,  2, 27,1,0,1, "maximum XOR size") \
 OPTION( elimxors,          1,  0,  1,0,0,1, "find XOR gates") \
 OPTION( emagluefast,      33,  1,2e9,0,0,1, "window fast glue") \
@@ -97,6 +110,9 @@ OPTION( flush,             0,  0,  1,0,0,1, "flush redundant clauses") \
 OPTION( flushfactor,       3,  1,1e3,0,0,1, "interval increase") \
 OPTION( flushint,        1e5,  1,2e9,0,0,1, "initial limit") \
 OPTION( forcephase,        0,  0,  1,0,0,1, "always use initial phase") \
+OPTION( gauss,             0,  0,  1,0,1,1, "root-level Gaussian elimination on XORs") \
+OPTION( gaussmaxsize,      5,  3,  6,0,0,1, "maximum XOR clause size") \
+OPTION( gaussmaxvars,    1e3,  2,1e4,1,0,1, "maximum variables per component") \
 OPTION( inprocessing,      1,  0,  1,0,0,1, "enable inprocessing") \
 OPTION( instantiate,       0,  0,  1,0,1,1, "variable instantiation") \
 OPTION( instantiateclslim, 3,  2,2e9,0,0,1, "minimum clause size") \
@@ -104,7 +120,13 @@ OPTION( instantiateocclim, 1,  1,2e9,2,0,1, "maximum occurrence limit") \
 OPTION( instantiateonce,   1,  0,  1,0,0,1, "instantiate each clause once") \
 LOGOPT( log,               0,  0,  1,0,0,0, "enable logging") \
 LOGOPT( logsort,           0,  0,  1,0,0,0, "sort logged clauses") \
+OPTION( lrb,               0,  0,  3,0,0,1, "learning rate branching (1=stable,2=focused,3=both)") \
+OPTION( lrbalpha,        400,  1,1e3,0,0,1, "initial LRB step size (per mille)") \
+OPTION( lrbalphadec,       1,  0,1e3,0,0,1, "LRB step size decrement (per million)") \
+OPTION( lrbalphamin,      60,  1,1e3,0,0,1, "minimum LRB step size (per mille)") \
+OPTION( lrbbcp,            0,  0,  1,0,0,1, "order delayed propagation by LRB") \
 OPTION( lucky,             1,  0,  1,0,0,1, "search for lucky phases") \
+OPTION( luckythreads,      1,  1,  8,0,0,1, "worker threads") \
 OPTION( minimize,          1,  0,  1,0,0,1, "minimize learned clauses") \
 OPTION( minimizedepth,   1e3,  0,1e3,0,0,1, "minimization depth") \
 OPTION( phase,             1,  0,  1,0,0,1, "initial phase") \
@@ -115,11 +137,13 @@ OPTION( probemaxeff,     1e8,  0,2e9,1,0,1, "maximum probing efficiency") \
 OPTION( probemineff,     1e6,  0,2e9,1,0,1, "minimum probing efficiency") \
 OPTION( probereleff,      20,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( proberounds,       1,  1, 16,1,0,1, "probing rounds" ) \
+OPTION( probetree,         2,  0,  8,0,0,1, "tree based probing depth" ) \
 OPTION( profile,           2,  0,  4,0,0,0, "profiling level") \
 QUTOPT( quiet,             0,  0,  1,0,0,0, "disable all messages") \
 OPTION( radixsortlim,    800,  0,2e9,0,0,1, "radix sort limit") \
 OPTION( realtime,          0,  0,  1,0,0,0, "real instead of process time") \
 OPTION( reduce,            1,  0,  1,0,0,1, "reduce useless clauses") \
+OPTION( reduceactivity,    0,  0,  1,0,0,1, "use clause activity in reduce") \
 OPTION( reduceint,       300, 10,1e6,0,0,1, "reduce interval") \
 OPTION( reducetarget,     75, 10,1e2,0,0,1, "reduce fraction in percent") \
 OPTION( reducetier1glue,   2,  1,2e9,0,0,1, "glue of kept learned clauses") \
@@ -131,12 +155,24 @@ OPTION( rephaseint,      1e3,  1,2e9,0,0,1, "rephase interval") \
 OPTION( report,reportdefault,  0,  1,0,0,1, "enable reporting") \
 OPTION( reportall,         0,  0,  1,0,0,1, "report even if not successful") \
 OPTION( reportsolve,       0,  0,  1,0,0,1, "use solving not process time") \
+OPTION( resetarm,         0,  0,  4,0,0,1, "force reset arm (1=full,2=decay,3=topk,4=noise)") \
+OPTION( resetdecay,       50,  0,1e2,0,0,1, "decay reset towards mean in percent") \
+OPTION( resetnoise,      100,  0,1e3,0,0,1, "noise reset perturbation per mille") \
 OPTION( resetrlbetadecay,  5e2,  0,1e3,1,0,0, "Reset RL thompson beta decay factor per mille") \
 OPTION( resetrlscoredecay, 5e2,  0,1e3,1,0,0, "Reset RL score decay factor per mille") \
+OPTION( resets,           0,  0,  1,0,0,1, "enable reset restarts selected by bandit") \
+OPTION( resettopk,       1e3,  1,2e9,0,0,1, "number of top scores randomized in reset") \
 OPTION( restart,           1,  0,  1,0,0,1, "enable restarts") \
 OPTION( restartint,        2,  1,2e9,0,0,1, "restart interval") \
 OPTION( restartmargin,    10,  0,1e2,0,0,1, "slow fast margin in percent") \
 OPTION( restartreusetrail, 1,  0,  1,0,0,1, "enable trail reuse") \
+OPTION( restartrl,         0,  0,  1,0,0,1, "select restart policy by bandit") \
+OPTION( restartrlbetadecay,5e2, 0,1e3,1,0,0, "Restart RL thompson beta decay factor per mille") \
+OPTION( restartrlgeom,   100,  1,2e9,0,0,1, "initial geometric restart interval") \
+OPTION( restartrlgeomfactor,150,101,1e4,0,0,1, "geometric restart interval factor in percent") \
+OPTION( restartrlint,    1e4,  1,2e9,0,0,1, "restart policy segment in conflicts") \
+OPTION( restartrlluby,   100,  1,2e9,0,0,1, "Luby restart period") \
+OPTION( restartrlscoredecay,5e2,0,1e3,1,0,0, "Restart RL score decay factor per mille") \
 OPTION( restoreall,        0,  0,  2,0,0,1, "restore all clauses (2=really)") \
 OPTION( restoreflush,      0,  0,  1,0,0,1, "remove satisfied clauses") \
 OPTION( reverse,           0,  0,  1,0,0,1, "reverse variable ordering") \
@@ -163,14 +199,16 @@ OPTION( subsumemaxeff,   1e8,  0,2e9,1,0,1, "maximum subsuming efficiency") \
 OPTION( subsumemineff,   1e6,  0,2e9,1,0,1, "minimum subsuming efficiency") \
 OPTION( subsumeocclim,   1e2,  0,2e9,1,0,1, "watch list length limit") \
 OPTION( subsumereleff,   1e3,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( subsumesig,        1,  0,  1,0,0,1, "use clause signatures") \
 OPTION( subsumestr,        1,  0,  1,0,0,1, "strengthen during subsume") \
+OPTION( subsumethreads,    1,  1, 64,0,0,1, "worker threads") \
 OPTION( target,            1,  0,  2,0,0,1, "target phases (1=stable only)") \
 OPTION( terminateint,     10,  0,1e4,0,0,1, "termination check interval") \
 OPTION( ternary,           1,  0,  1,0,1,1, "hyper ternary resolution") \
 OPTION( ternarymaxadd,   1e3,  0,1e4,1,0,1, "max clauses added in percent") \
 OPTION( ternarymaxeff,   1e8,  0,2e9,1,0,1, "ternary maximum efficiency") \
 OPTION( ternarymineff,   1e6,  1,2e9,1,0,1, "minimum ternary efficiency") \
-OPTION( ternaryocclim,   1e2,  1,2e9,2,0,1, "ternary occurrence limit") \
+OPTION( ternaryocclim,   1e3,  1,2e9,2,0,1, "ternary occurrence limit") \
 OPTION( ternaryreleff,    10,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( ternaryrounds,     2,  1, 16,1,0,1, "maximum ternary rounds") \
 OPTION( transred,          1,  0,  1,0,1,1, "transitive reduction of BIG") \
@@ -184,12 +222,15 @@ OPTION( vivifymineff,    2e4,  0,2e9,1,0,1, "minimum efficiency") \
 OPTION( vivifyonce,        0,  0,  2,0,0,1, "vivify once: 1=red, 2=red+irr") \
 OPTION( vivifyredeff,     75,  0,1e3,1,0,1, "redundant efficiency per mille") \
 OPTION( vivifyreleff,     20,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( vivifytier2,      75,  0,1e2,0,0,1, "tier two effort in percent") \
 OPTION( walk,              1,  0,  1,0,0,1, "enable random walks") \
 OPTION( walkmaxeff,      1e7,  0,2e9,1,0,1, "maximum efficiency") \
 OPTION( walkmineff,      1e5,  0,1e7,1,0,1, "minimum efficiency") \
 OPTION( walknonstable,     1,  0,  1,0,0,1, "walk in non-stabilizing phase") \
 OPTION( walkredundant,     0,  0,  1,0,0,1, "walk redundant clauses too") \
 OPTION( walkreleff,       20,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( walkthread,        0,  0,  1,0,0,1, "local search in background thread") \
+OPTION( xors,              0,  0,  1,0,1,1, "native XOR constraints") \
 
 // Note, keep an empty line right before this line because of the last '\'!
 // Also keep those single spaces after 'OPTION(' for proper sorting.
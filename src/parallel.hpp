@@ -0,0 +1,41 @@
+#ifndef _parallel_hpp_INCLUDED
+#define _parallel_hpp_INCLUDED
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
+#include <vector>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Some simplification algorithms split their work into independent parts
+// which only read shared solver data and write to part specific buffers.
+// The results are then merged deterministically in the calling thread.
+// This function runs 'work (i)' for all 'i' in the range '[0,n)' in 'n'
+// threads, where part zero is executed by the calling thread itself.  It
+// returns after all parts are completed.  If the solver is compiled
+// without thread support ('NTHREADS' defined by './configure
+// --no-threads') the parts are simply run sequentially in order.
+
+template<class Work> void run_in_parallel (unsigned n, Work work) {
+#ifndef NTHREADS
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < n; i++)
+    workers.push_back (std::thread (work, i));
+  if (n) work (0u);
+  for (auto & worker : workers)
+    worker.join ();
+#else
+  for (unsigned i = 0; i < n; i++)
+    work (i);
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+}
+
+#endif
@@ -543,6 +543,109 @@ int Internal::next_probe () {
   }
 }
 
+/*------------------------------------------------------------------------*/
+
+// Tree based probing following the 'tree look' idea of our CPAIOR'13 paper
+// on tree based look ahead (and earlier work by Heule et.al. on 'march').
+// If 'a' implies 'b' through a binary clause, then the propagation of 'a'
+// contains the propagation of 'b'.  Thus instead of probing several roots
+// implying 'b' independently, we propagate 'b' once and then probe these
+// roots nested on top of it on decision level one, undoing only the
+// assignments of the nested probe afterwards.  This is applied recursively
+// along a depth-first search over binary clauses up to 'probetree' levels.
+
+// Since the nested probe implies the previous (nested) decisions, the
+// trail on decision level one is still an implication tree, but rooted in
+// the latest nested probe.  We make this explicit by setting the parent of
+// the previous decision to the new probe and give the new probe a smaller
+// trail position than the previous decision.  This keeps 'probe_dominator',
+// on-the-fly hyper binary resolution and 'failed_literal' unchanged.
+
+// Find the node below the root 'probe' at which the tree is started, by
+// walking along binary implications to literals which are implied by the
+// most binary clauses (which in turn are the children in the tree).
+
+int Internal::probe_tree_top (int probe) {
+  int res = probe;
+  for (int depth = 0; depth < opts.probetree; depth++) {
+    size_t max_children = 1;
+    int best = 0;
+    for (const auto & w : watches (-res)) {
+      if (!w.binary ()) continue;
+      if (w.clause->garbage) continue;
+      const int implied = w.blit;
+      if (val (implied)) continue;
+      if (!active (implied)) continue;
+      size_t children = 0;
+      for (const auto & v : watches (implied))
+        if (v.binary ()) children++;
+      if (children <= max_children) continue;
+      max_children = children;
+      best = implied;
+    }
+    if (!best) break;
+    res = best;
+  }
+  if (res != probe) LOG ("starting probing tree of %d at %d", probe, res);
+  return res;
+}
+
+// Probe the children of the latest (nested) probe 'lit', i.e., literals
+// implying 'lit' through a binary clause.  Returns 'false' if a failed
+// literal was found, in which case we already backtracked to the root.
+
+bool Internal::probe_tree (int lit, int depth, int64_t limit) {
+
+  if (!depth) return true;
+
+  assert (level == 1);
+  assert (val (lit) > 0);
+  assert (!get_parent_reason_literal (lit));
+
+  vector<int> children;
+  for (const auto & w : watches (lit)) {
+    if (!w.binary ()) continue;
+    if (w.clause->garbage) continue;
+    const int child = -w.blit;
+    if (val (child)) continue;
+    children.push_back (child);
+  }
+
+  for (const auto & child : children) {
+
+    if (terminated_asynchronously ()) break;
+    if (stats.propagations.probe >= limit) break;
+
+    if (val (child)) continue;
+    if (!active (child)) continue;
+    if (propfixed (child) >= stats.all.fixed) continue;
+
+    stats.probed++;
+    stats.probetree++;
+    LOG ("tree probing %d implying %d", child, lit);
+
+    const size_t saved = trail.size ();
+    const int key = var (lit).trail - 1;
+    set_parent_reason_literal (lit, child);
+    probe_assign (child, 0);
+    var (child).trail = key;
+
+    if (!probe_propagate ()) {
+      failed_literal (child);
+      return false;
+    }
+
+    if (!probe_tree (child, depth - 1, limit)) return false;
+
+    backtrack_trail (saved);
+    set_parent_reason_literal (lit, 0);
+  }
+
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
 bool Internal::probe_round () {
 
   if (unsat) return false;
@@ -593,6 +696,19 @@ bool Internal::probe_round () {
          (probe = next_probe ())) {
     stats.probed++;
     LOG ("probing %d", probe);
+    const int top = probe_tree_top (probe);
+    probe_assign_decision (top);
+    if (!probe_propagate ()) failed_literal (top);
+    else if (probe_tree (top, opts.probetree, limit)) backtrack ();
+
+    // The root might not have been reached in the tree, because a failed
+    // literal was found, the limit was hit or a literal on the way was
+    // already probed before.  Then probe it directly.
+
+    if (unsat || top == probe) continue;
+    if (!active (probe) || val (probe)) continue;
+    if (propfixed (probe) >= stats.all.fixed) continue;
+    LOG ("probing %d directly", probe);
     probe_assign_decision (probe);
     if (probe_propagate ()) backtrack ();
     else failed_literal (probe);
@@ -632,6 +748,8 @@ bool Internal::probe_round () {
 void CaDiCaL::Internal::probe (bool update_limits) {
 
   if (unsat) return;
+  reset_amos ();
+  reset_xors ();
   if (level) backtrack ();
   if (!propagate ()) { learn_empty_clause (); return; }
 
@@ -646,10 +764,14 @@ void CaDiCaL::Internal::probe (bool update_limits) {
   if (ternary ())       // If we derived a binary clause
     decompose ();       // then start another round of ELS.
 
+  if (gauss ())         // Same if Gaussian elimination on XORs derived
+    decompose ();       // equivalences.
+
   // Remove duplicated binary clauses and perform in essence hyper unary
   // resolution, i.e., derive the unit '2' from '1 2' and '-1 2'.
   //
   mark_duplicated_binary_clauses_as_garbage ();
+  mark_duplicated_clauses_as_garbage ();
 
   for (int round = 1; round <= opts.proberounds; round++)
     if (!probe_round ())
@@ -38,6 +38,7 @@ struct Internal;
 /*------------------------------------------------------------------------*/
 
 #define PROFILES \
+PROFILE(amo,3) \
 PROFILE(analyze,3) \
 PROFILE(backward,3) \
 PROFILE(block,2) \
@@ -54,6 +55,7 @@ PROFILE(decide,3) \
 PROFILE(decompose,3) \
 PROFILE(elim,2) \
 PROFILE(extend,3) \
+PROFILE(gauss,2) \
 PROFILE(instantiate,2) \
 PROFILE(lucky,2) \
 PROFILE(lookahead,2) \
@@ -77,6 +79,7 @@ PROFILE(transred,3) \
 PROFILE(unstable,2) \
 PROFILE(vivify,2) \
 PROFILE(walk,2) \
+PROFILE(xors,3) \
 
 /*------------------------------------------------------------------------*/
 
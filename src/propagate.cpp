@@ -31,6 +31,9 @@ inline int Internal::assignment_level (int lit, Clause * reason) {
 
   assert (opts.chrono);
   if (!reason) return level;
+  if (reason == &amo_reason) return var (amoreasons[vidx (lit)]).level;
+  if (reason == &xor_reason)
+    return var (xors[xorreasons[vidx (lit)] + 5]).level; // second watch
 
   int res = 0;
 
@@ -67,8 +70,14 @@ inline void Internal::search_assign (int lit, Clause * reason) {
 
   v.level = lit_level;
   v.reason = reason;
+  if (opts.lrb) lrb_assigned (idx);
   if (!lit_level) learn_unit_clause (lit);  // increases 'stats.fixed'
-  search_enqueue<bcp_mode> (idx, lit);
+
+  // Root-level units are marked fixed right away and thus are assigned
+  // immediately, since delayed assignments are dropped on conflicts.
+  //
+  if (!lit_level) search_enqueue_immediate (idx, lit);
+  else search_enqueue<bcp_mode> (idx, lit);
   if (!searching_lucky_phases)
     phases.saved[idx] = sign (lit);                // phase saving during search
 #ifdef LOGGING
@@ -198,7 +207,10 @@ inline bool Internal::search_found_conflict_delayed (const int lit) {
 
 inline void Internal::search_clear_prop_queue () {
   propagated = trail.size ();
-  for (int idx : scores_bcp) vals_bcp[idx] = vals_bcp[-idx] = 0;
+  for (int idx : scores_bcp) {
+    vals_bcp[idx] = vals_bcp[-idx] = 0;
+    if (opts.lrb) lrbtab[idx].assigned = -1;
+  }
   scores_bcp.clear ();
 }
 
@@ -234,6 +246,110 @@ void Internal::search_assign_driving (int lit, Clause * c) {
 
 /*------------------------------------------------------------------------*/
 
+// Propagate the at-most-one constraints (see 'amo.cpp') in which the
+// literal 'lit' just assigned to true occurs, by assigning all other
+// literals in these constraints to false.  These assignments only get the
+// pseudo reason 'amo_reason', which is explained lazily in conflict
+// analysis.  Only for a conflict the binary clause is determined here.
+
+template <Internal::BCPMode bcp_mode>
+inline void Internal::propagate_amos (int lit) {
+  const auto & occs = amotab[vlit (lit)];
+  for (const auto & start : occs) {
+    for (const int * p = &amos[start]; *p; p++) {
+      const int other = *p;
+      if (other == lit) continue;
+      if (val (other) < 0) continue;
+      if (bcp_mode == BCPMode::DELAYED && val_bcp (other) < 0) continue;
+      if (search_found_conflict<bcp_mode> (-other)) {
+        conflict = find_amo_binary (lit, -other);
+        return;
+      }
+      amoreasons[vidx (other)] = lit;
+      search_assign<bcp_mode> (-other, &amo_reason);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Propagate the XOR constraints (see 'gauss.cpp') watched by the variable
+// of the literal 'lit' just assigned.  As for clauses we try to find an
+// unassigned replacement variable to watch.  Otherwise all variables but
+// the other watched one are assigned and the XOR either forces the other
+// watched variable with the pseudo reason 'xor_reason' or it is checked
+// for a conflict.  In both cases the watches are moved to the variables
+// assigned last (with the highest level), such that backtracking never
+// unassigns an unwatched variable without unassigning a watched one.
+// Thus the second watched variable has the assignment level of a variable
+// forced by the XOR (see 'assignment_level').
+
+template <Internal::BCPMode bcp_mode>
+inline void Internal::propagate_xors (int lit) {
+  const int idx = vidx (lit);
+  auto & ws = xortab[idx];
+  const auto end = ws.end ();
+  auto j = ws.begin (), i = j;
+  while (i != end) {
+    const unsigned start = *j++ = *i++;
+    if (conflict) continue;
+    int * x = &xors[start];
+    const int size = x[0];
+    int * v = x + 4;
+    if (v[0] == idx) swap (v[0], v[1]);
+    assert (v[1] == idx);
+    int k = 2;
+    while (k < size && val (v[k])) k++;
+    if (k < size) {
+      swap (v[1], v[k]);
+      xortab[v[1]].push_back (start);
+      j--;
+      continue;
+    }
+    bool positive = x[1];
+    int high = 1;
+    for (k = 1; k < size; k++) {
+      const int other = v[k];
+      if (val (other) > 0) positive = !positive;
+      if (var (other).level > var (v[high]).level) high = k;
+    }
+    if (high != 1) {
+      swap (v[1], v[high]);
+      xortab[v[1]].push_back (start);
+      j--;
+    }
+    const signed char tmp = val (v[0]);
+    if (tmp) {
+      int second = 0;
+      for (k = 2; k < size; k++)
+        if (var (v[k]).level > var (v[second]).level) second = k;
+      if (second) {
+        auto & os = xortab[v[0]];
+        auto p = find (os.begin (), os.end (), start);
+        assert (p != os.end ());
+        *p = os.back ();
+        os.pop_back ();
+        swap (v[0], v[second]);
+        if (v[0] == idx) *j++ = start;
+        else xortab[v[0]].push_back (start);
+      }
+      if ((tmp > 0) != positive) conflict = find_xor_clause (start, 0);
+      continue;
+    }
+    const int implied = positive ? v[0] : -v[0];
+    if (bcp_mode == BCPMode::DELAYED && val_bcp (implied) > 0) continue;
+    if (search_found_conflict<bcp_mode> (implied)) {
+      conflict = find_xor_clause (start, 0);
+      continue;
+    }
+    xorreasons[v[0]] = start;
+    search_assign<bcp_mode> (implied, &xor_reason);
+  }
+  ws.resize (j - ws.begin ());
+}
+
+/*------------------------------------------------------------------------*/
+
 // The 'propagate' function is usually the hot-spot of a CDCL SAT solver.
 // The 'trail' stack saves assigned variables and is used here as BFS queue
 // for checking clauses with the negation of assigned variables for being in
@@ -452,6 +568,9 @@ inline bool Internal::propagate_internal () {
 
       ws.resize (j - ws.begin ());
     }
+
+    if (!conflict && !amos.empty ()) propagate_amos<bcp_mode> (-lit);
+    if (!conflict && !xors.empty ()) propagate_xors<bcp_mode> (-lit);
   }
 
   if (searching_lucky_phases) {
@@ -54,14 +54,33 @@ void Internal::mark_clauses_to_be_flushed () {
 // In earlier versions we pre-computed a 64-bit sort key per clause and
 // wrapped a pointer to the clause and the 64-bit sort key into a separate
 // data structure for sorting.  This was probably faster but awkward and
-// so we moved back to a simpler scheme which also uses 'stable_sort'
-// instead of 'rsort' below.  Sorting here is not a hot-spot anyhow.
+// so we moved back to a simpler scheme which used 'stable_sort' instead of
+// 'rsort' below.  Now only a partial selection is computed anyhow.
+
+// Reduce candidates remember their position in 'clauses', which allows to
+// break ties in favor of keeping more recently learned clauses without
+// having to use stable sorting (see below).
+
+struct ReduceCandidate {
+  Clause * clause;
+  size_t position;
+};
 
 struct reduce_less_useful {
-  bool operator () (const Clause * c, const Clause * d) const {
+  bool activity;
+  reduce_less_useful (bool a) : activity (a) { }
+  bool operator () (const ReduceCandidate & a,
+                    const ReduceCandidate & b) const {
+    const Clause * c = a.clause, * d = b.clause;
     if (c->glue > d->glue) return true;
     if (c->glue < d->glue) return false;
-    return c->size > d->size;
+    if (activity) {
+      if (c->activity < d->activity) return true;
+      if (c->activity > d->activity) return false;
+    }
+    if (c->size > d->size) return true;
+    if (c->size < d->size) return false;
+    return a.position < b.position;
   }
 };
 
@@ -71,19 +90,28 @@ struct reduce_less_useful {
 
 void Internal::mark_useless_redundant_clauses_as_garbage () {
 
-  // We use a separate stack for sorting candidates for removal.  This uses
-  // (slightly) more memory but has the advantage to keep the relative order
-  // in 'clauses' intact, which actually due to using stable sorting goes
-  // into the candidate selection (more recently learned clauses are kept if
-  // they otherwise have the same glue and size).
+  // We use a separate stack for selecting candidates for removal.  This
+  // uses (slightly) more memory but has the advantage to keep the relative
+  // order in 'clauses' intact, which actually goes into the candidate
+  // selection (more recently learned clauses are kept if they otherwise
+  // have the same glue and size).  Since only the 'target' least useful
+  // clauses have to be determined but not their order, a partial selection
+  // with 'nth_element' in linear time is enough.  Ties are broken by the
+  // position in 'clauses', which gives exactly the same selection as
+  // stable sorting all candidates.  With 'reduceactivity' the clause
+  // activity (bumped in 'bump_clause' and halved here) is used to compare
+  // clauses with the same glue before comparing their size.
 
-  vector<Clause *> stack;
+  vector<ReduceCandidate> stack;
 
   stack.reserve (stats.current.redundant);
 
+  const bool activity = opts.reduceactivity;
+
   for (const auto & c : clauses) {
     if (!c->redundant) continue;    // Keep irredundant.
     if (c->garbage) continue;       // Skip already marked.
+    if (activity) c->activity >>= 1;
     if (c->reason) continue;        // Need to keep reasons.
     const unsigned used = c->used;
     if (used) c->used--;
@@ -95,11 +123,9 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
     if (used) continue;             // Do keep recently used clauses.
     if (c->keep) continue;          // Forced to keep (see above).
 
-    stack.push_back (c);
+    stack.push_back (ReduceCandidate { c, stack.size () });
   }
 
-  stable_sort (stack.begin (), stack.end (), reduce_less_useful ());
-
   size_t target = 1e-2 * opts.reducetarget * stack.size ();
 
   // This is defensive code, which I usually consider a bug, but here I am
@@ -108,13 +134,16 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
   //
   if (target > stack.size ()) target = stack.size ();
 
+  nth_element (stack.begin (), stack.begin () + target, stack.end (),
+    reduce_less_useful (activity));
+
   PHASE ("reduce", stats.reductions, "reducing %zd clauses %.0f%%",
     target, percent (target, stats.current.redundant));
 
   auto i = stack.begin ();
   const auto t = i + target;
   while (i != t) {
-    Clause * c = *i++;
+    Clause * c = (i++)->clause;
     LOG (c, "marking useless to be collected");
     mark_garbage (c);
     stats.reduced++;
@@ -124,7 +153,7 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
 
   const auto end = stack.end ();
   for (i = t; i != end; i++) {
-    Clause * c = *i;
+    Clause * c = i->clause;
     LOG (c, "keeping");
     if (c->size > lim.keptsize) lim.keptsize = c->size;
     if (c->glue > lim.keptglue) lim.keptglue = c->glue;
@@ -90,8 +90,20 @@ char Internal::rephase_best () {
 
 // Trigger local search 'walk' in 'walk.cpp'.
 
+// With a background local search thread its best phases are imported
+// instead of running local search, unless it did not find a new assignment
+// since the last import.  The worker is restarted on a new snapshot if
+// the irredundant clauses changed.
+
 char Internal::rephase_walk () {
   stats.rephased.walk++;
+  if (opts.walkthread) {
+    const bool imported = import_walk_thread_phases ();
+    if (walkthread && walkthread->signature != walk_thread_signature ())
+      stop_walk_thread ();
+    if (!walkthread) start_walk_thread ();
+    if (imported) return 'W';
+  }
   PHASE ("rephase", stats.rephased.total,
     "starting local search to improve current phase");
   walk ();
@@ -217,7 +217,7 @@ void Internal::report (char type, int verbose) {
     case 's': case 'v': case 'w':
     case 't': case 'b': case 'c': tout.green (false); break;
     case 'e':                     tout.green (true); break;
-    case 'p': case '2': case '3': tout.blue (false); break;
+    case 'p': case '2': case '3': case 'x': tout.blue (false); break;
     case 'd':                     tout.blue (true); break;
     case 'z': case 'f':           tout.cyan (true); break;
     case '-':                     tout.normal (); break;
@@ -54,7 +54,15 @@ bool Internal::stabilizing () {
 bool Internal::restarting () {
   if (!opts.restart) return false;
   if ((size_t) level < assumptions.size () + 2) return false;
+  if (opts.restartrl) {
+    (void) stabilizing ();      // Still alternate between phases.
+    return restarting_by_policy ();
+  }
   if (stabilizing ()) return reluctant;
+  return restarting_by_glue ();
+}
+
+bool Internal::restarting_by_glue () {
   if (stats.conflicts <= lim.restart) return false;
   double f = averages.current.glue.fast;
   double margin = (100.0 + opts.restartmargin)/100.0;
@@ -77,7 +85,11 @@ int Internal::reuse_trail () {
   int decision = next_decision_variable ();
   assert (1 <= decision);
   int res = trivial_decisions;
-  if (use_scores ()) {
+  if (use_lrb ()) {
+    while (res < level &&
+           lrb_smaller (this)(decision, abs (control[res+1].decision)))
+      res++;
+  } else if (use_scores ()) {
     while (res < level &&
            score_smaller (this)(decision, abs (control[res+1].decision)))
       res++;
@@ -108,15 +120,25 @@ void Internal::clear_scores_rl () {
 }
 
 template <Internal::RLScoreType scoretype>
-inline double Internal::get_prev_round_score_rl () {
+static inline double get_round_score_rl (int64_t lbdsum, int64_t conflicts,
+                                         int64_t decisions,
+                                         int64_t propagations) {
   switch (scoretype) {
-    case RLScoreType::LBD: return rl_lbdsum / static_cast<double>(stats.learned.clauses - rl_prevConflicts);
-    case RLScoreType::GLR: return (stats.learned.clauses - rl_prevConflicts) / static_cast<double>(stats.decisions - rl_prevDecisions);
-    case RLScoreType::PPD: return (stats.propagations.search - rl_prevPropagations) / static_cast<double>(stats.decisions - rl_prevDecisions);
+    case Internal::RLScoreType::LBD: return lbdsum / static_cast<double>(conflicts);
+    case Internal::RLScoreType::GLR: return conflicts / static_cast<double>(decisions);
+    case Internal::RLScoreType::PPD: return propagations / static_cast<double>(decisions);
     default: __builtin_unreachable ();
   }
 }
 
+template <Internal::RLScoreType scoretype>
+inline double Internal::get_prev_round_score_rl () {
+  return get_round_score_rl<scoretype> (rl_lbdsum,
+    stats.learned.clauses - rl_prevConflicts,
+    stats.decisions - rl_prevDecisions,
+    stats.propagations.search - rl_prevPropagations);
+}
+
 // Solver configuration
 static constexpr Internal::RLScoreType BCP_SCORETYPE       = Internal::RLScoreType::LBD;
 static constexpr Internal::RLScoreType RESET_SCORETYPE     = Internal::RLScoreType::GLR;
@@ -150,18 +172,148 @@ inline Internal::RestartMode Internal::update_restart_mode_rl () {
 
   // Pick whether to perform a reset
   restartmode = static_cast<RestartMode>(resetrl_thompson.select_lever ());
-  if (restartmode == RestartMode::RESET) stats.resets++;
+  if (opts.resetarm && restartmode != RestartMode::RESTART)
+    restartmode = static_cast<RestartMode>(opts.resetarm);
+  switch (restartmode) {
+    case RestartMode::RESTART: break;
+    case RestartMode::RESET: stats.resets++, stats.resetrl.full++; break;
+    case RestartMode::DECAY: stats.resets++, stats.resetrl.decay++; break;
+    case RestartMode::TOPK:  stats.resets++, stats.resetrl.topk++;  break;
+    case RestartMode::NOISE: stats.resets++, stats.resetrl.noise++; break;
+    default: __builtin_unreachable ();
+  }
   return restartmode;
 }
 
-inline void Internal::reset_scores () {
+// Instead of the fixed restart schedule (Glucose style restarts in focused
+// mode and reluctant doubling in stable mode) a bandit can select the
+// restart policy for segments of 'restartrlint' conflicts.  At the end of
+// a segment its policy is rewarded with the same score as the BCP mode
+// after a restart, but computed over the whole segment.
+
+inline Internal::RestartPolicy Internal::update_restart_policy_rl () {
+  if (stats.restartrl.segments) {
+    // Update (bump and decay) reward values
+    const double prevSegmentScore = get_round_score_rl<BCP_SCORETYPE> (
+      restartrl_lbdsum,
+      stats.learned.clauses - restartrl_prevConflicts,
+      stats.decisions - restartrl_prevDecisions,
+      stats.propagations.search - restartrl_prevPropagations);
+    restartrl_thompson.update_dist(static_cast<size_t>(restartpolicy), prevSegmentScore >= restartrl_historicalScore, 1e-3 * opts.restartrlbetadecay);
+
+    // Update historical score as a weighted average
+    const double DECAY_FACTOR = 1e-3 * opts.restartrlscoredecay;
+    restartrl_historicalScore = restartrl_historicalScore * DECAY_FACTOR + prevSegmentScore * (1 - DECAY_FACTOR);
+  }
+
+  restartrl_lbdsum           = 0;
+  restartrl_prevConflicts    = stats.learned.clauses;
+  restartrl_prevDecisions    = stats.decisions;
+  restartrl_prevPropagations = stats.propagations.search;
+
+  // Pick the restart policy for the next segment
+  restartpolicy = static_cast<RestartPolicy>(restartrl_thompson.select_lever ());
+  stats.restartrl.segments++;
+  switch (restartpolicy) {
+    case RestartPolicy::GLUE: stats.restartrl.glue++; break;
+    case RestartPolicy::LUBY: stats.restartrl.luby++; break;
+    case RestartPolicy::GEOMETRIC:
+      stats.restartrl.geometric++;
+      inc.restartgeom = opts.restartrlgeom;
+      lim.restartgeom = stats.conflicts + inc.restartgeom;
+      break;
+    case RestartPolicy::NONE: stats.restartrl.none++; break;
+    default: __builtin_unreachable ();
+  }
+  LOG ("selected restart policy %d for the next %d conflicts",
+    (int) restartpolicy, opts.restartrlint);
+  return restartpolicy;
+}
+
+bool Internal::restarting_by_policy () {
+  if (stats.conflicts >= lim.restartpolicy) {
+    update_restart_policy_rl ();
+    lim.restartpolicy = stats.conflicts + opts.restartrlint;
+  }
+  switch (restartpolicy) {
+    case RestartPolicy::GLUE: return restarting_by_glue ();
+    case RestartPolicy::LUBY: return restartrl_luby;
+    case RestartPolicy::GEOMETRIC:
+      if (stats.conflicts < lim.restartgeom) return false;
+      // Round up, since otherwise small intervals would never grow.
+      inc.restartgeom =
+        (inc.restartgeom * opts.restartrlgeomfactor + 99) / 100;
+      lim.restartgeom = stats.conflicts + inc.restartgeom;
+      return true;
+    case RestartPolicy::NONE: return false;
+    default: __builtin_unreachable ();
+  }
+}
+
+// Besides randomizing all scores, which discards all learned activity and
+// requires to rebuild the whole heap, there are gentler and cheaper reset
+// arms.  Decaying scores towards their mean keeps their relative order
+// (except for rounding to ties), randomizing only the top scores touches
+// 'resettopk' variables and perturbing scores by noise proportional to
+// their activity only needs a linear bottom-up rebuild of the heap.
+
+void Internal::randomize_scores () {
   constexpr double SCALE_FACTOR = 1e-3;
   assert (!level);
 
-  scores.clear();
-  for (int idx = max_var; idx; idx--) {
+  for (int idx = max_var; idx; idx--)
     stab[idx] = rl_random.generate_double() * SCALE_FACTOR;
-    scores.push_back(idx);
+  scores.build (vars);
+  stats.heapified++;
+}
+
+void Internal::decay_scores () {
+  assert (!level);
+  if (!max_var) return;
+  double sum = 0;
+  for (auto idx : vars) sum += stab[idx];
+  const double mean = sum / max_var;
+  const double factor = 1 - 1e-2 * opts.resetdecay;
+  for (auto idx : vars) stab[idx] = mean + (stab[idx] - mean) * factor;
+  scores.heapify ();
+  stats.heapified++;
+  LOG ("decayed scores by %g towards mean %g", factor, mean);
+}
+
+void Internal::randomize_top_scores () {
+  assert (!level);
+  vector<int> top;
+  while (!scores.empty () && top.size () < (size_t) opts.resettopk)
+    top.push_back (scores.pop_front ());
+  if (top.empty ()) return;
+  const double max_score = stab[top.front ()];
+  const double min_score = stab[top.back ()];
+  for (const auto idx : top) {
+    const double r = rl_random.generate_double ();
+    stab[idx] = min_score + (max_score - min_score) * r;
+    scores.push_back (idx);
+  }
+  LOG ("randomized %zd top scores in [%g,%g]",
+    top.size (), min_score, max_score);
+}
+
+void Internal::perturb_scores () {
+  assert (!level);
+  const double noise = 1e-3 * opts.resetnoise;
+  for (auto idx : vars)
+    stab[idx] *= 1 - noise * rl_random.generate_double ();
+  scores.heapify ();
+  stats.heapified++;
+  LOG ("perturbed scores with noise %g", noise);
+}
+
+inline void Internal::reset_scores () {
+  switch (restartmode) {
+    case RestartMode::RESET: randomize_scores (); break;
+    case RestartMode::DECAY: decay_scores (); break;
+    case RestartMode::TOPK:  randomize_top_scores (); break;
+    case RestartMode::NOISE: perturb_scores (); break;
+    default: __builtin_unreachable ();
   }
 }
 
@@ -173,7 +325,7 @@ void Internal::restart () {
   LOG ("restart %" PRId64 "", stats.restarts);
 
   // Check if we should reset
-  if (ENABLE_RESETS && update_restart_mode_rl () == RestartMode::RESET) {
+  if (opts.resets && update_restart_mode_rl () != RestartMode::RESTART) {
     const int trivial_decisions = assumptions.size ()
       // Plus 1 if the constraint is satisfied via implications of assumptions
       // and a pseudo-decision level was introduced
@@ -190,6 +342,8 @@ void Internal::restart () {
   // Update BCP scores for randomized priority order
 #if PBCP_ORDER == PBCP_ORDER_RANDOM
   for (int idx = max_var; idx; idx--) stab_bcp[idx] = rl_random.generate_double();
+  scores_bcp.heapify ();
+  stats.heapified++;
 #endif
 
   // Pick the next BCP mode
@@ -198,7 +352,7 @@ void Internal::restart () {
   else if (ENABLE_PBCP_RANDOM) update_bcp_mode_random ();
   (bcpmode == BCPMode::IMMEDIATE ? stats.bcprl.immediate : stats.bcprl.delayed)++;
 
-  if (ENABLE_RESETS || ENABLE_PBCP) clear_scores_rl ();
+  if (opts.resets || ENABLE_PBCP) clear_scores_rl ();
 
   report ('R', 2);
   STOP (restart);
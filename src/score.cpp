@@ -40,10 +40,10 @@ void Internal::shuffle_scores () {
     }
   }
   score_inc = 0;
-  for (const auto & idx : shuffle) {
+  for (const auto & idx : shuffle)
     stab[idx] = score_inc++;
-    scores.push_back (idx);
-  }
+  scores.build (shuffle);
+  stats.heapified++;
 }
 
 }
@@ -15,7 +15,14 @@ struct score_smaller_bcp {
   bool operator () (unsigned a, unsigned b);
 };
 
+struct score_smaller_branching {
+  Internal * internal;
+  score_smaller_branching (Internal * i) : internal (i) { }
+  bool operator () (unsigned a, unsigned b);
+};
+
 typedef heap<score_smaller> ScoreSchedule;
+typedef heap<score_smaller_branching> ScoreScheduleBranching;
 typedef heap<score_smaller_bcp> ScoreScheduleBCP;
 
 }
@@ -212,17 +212,18 @@ namespace CaDiCaL {
     unsigned open = 0;
  #ifndef NDEBUG
     const Flags&f = flags(uip);
-#endif
     const Var&v = var(uip);
+#endif
 
     assert(f.shrinkable);
     assert(v.level == blevel);
     assert(v.reason);
+    const Clause *reason = explained_reason(uip);
 
-    if (resolve_large_clauses || v.reason->size == 2)
+    if (resolve_large_clauses || reason->size == 2)
       {
-        const Clause &c = *v.reason;
-        LOG(v.reason, "resolving with reason");
+        const Clause &c = *reason;
+        LOG(reason, "resolving with reason");
         for(int lit : c) {
           if(lit == uip)
             continue;
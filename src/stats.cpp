@@ -57,9 +57,29 @@ void Stats::print (Internal * internal) {
   PRT ("immediate bcp:   %15" PRId64 "   %10.2f %%", stats.bcprl.immediate, percent (stats.bcprl.immediate, stats.bcprl.immediate + stats.bcprl.delayed));
   PRT ("delayed bcp:     %15" PRId64 "   %10.2f %%", stats.bcprl.delayed, percent (stats.bcprl.delayed, stats.bcprl.immediate + stats.bcprl.delayed));
   PRT ("resets:          %15" PRId64 "   %10.2f %% of restarts", stats.resets, percent (stats.resets, stats.restarts));
+  if (all || stats.resets) {
+  PRT ("  full:          %15" PRId64 "   %10.2f %%  of resets", stats.resetrl.full, percent (stats.resetrl.full, stats.resets));
+  PRT ("  decay:         %15" PRId64 "   %10.2f %%  of resets", stats.resetrl.decay, percent (stats.resetrl.decay, stats.resets));
+  PRT ("  topk:          %15" PRId64 "   %10.2f %%  of resets", stats.resetrl.topk, percent (stats.resetrl.topk, stats.resets));
+  PRT ("  noise:         %15" PRId64 "   %10.2f %%  of resets", stats.resetrl.noise, percent (stats.resetrl.noise, stats.resets));
+  }
+  if (all || stats.restartrl.segments) {
+  PRT ("restart policies:%15" PRId64 "   %10.2f    interval", stats.restartrl.segments, relative (stats.conflicts, stats.restartrl.segments));
+  PRT ("  glue:          %15" PRId64 "   %10.2f %%  of segments", stats.restartrl.glue, percent (stats.restartrl.glue, stats.restartrl.segments));
+  PRT ("  luby:          %15" PRId64 "   %10.2f %%  of segments", stats.restartrl.luby, percent (stats.restartrl.luby, stats.restartrl.segments));
+  PRT ("  geometric:     %15" PRId64 "   %10.2f %%  of segments", stats.restartrl.geometric, percent (stats.restartrl.geometric, stats.restartrl.segments));
+  PRT ("  none:          %15" PRId64 "   %10.2f %%  of segments", stats.restartrl.none, percent (stats.restartrl.none, stats.restartrl.segments));
+  }
 
   SECTION ("statistics");
 
+  if (all || stats.amos) {
+  PRT ("amos:            %15" PRId64 "   %10.2f    per phase", stats.amos, relative (stats.amos, stats.amophases));
+  PRT ("  phases:        %15" PRId64 "   %10.2f    interval", stats.amophases, relative (stats.conflicts, stats.amophases));
+  PRT ("  binaries:      %15" PRId64 "   %10.2f    per AMO", stats.amobins, relative (stats.amobins, stats.amos));
+  PRT ("  explanations:  %15" PRId64 "   %10.2f %%  per conflict", stats.amoexpls, percent (stats.amoexpls, stats.conflicts));
+  PRT ("  resets:        %15" PRId64 "   %10.2f    interval", stats.amoresets, relative (stats.conflicts, stats.amoresets));
+  }
   if (all || stats.blocked) {
   PRT ("blocked:         %15" PRId64 "   %10.2f %%  of irredundant clauses", stats.blocked, percent (stats.blocked, stats.added.irredundant));
   PRT ("  blockings:     %15" PRId64 "   %10.2f    internal", stats.blockings, relative (stats.conflicts, stats.blockings));
@@ -87,16 +107,21 @@ void Stats::print (Internal * internal) {
   PRT ("  condcondrem:   %19.3f  %7.2f %%  final conditional", relative (stats.condcondrem, stats.conditioned), percent (stats.condcondrem, stats.condassrem));
   PRT ("  condautrem:    %19.3f  %7.2f %%  final autarky", relative (stats.condautrem, stats.conditioned), percent (stats.condautrem, stats.condassrem));
   PRT ("  condprops:     %15" PRId64 "   %10.2f    per candidate", stats.condprops, relative (stats.condprops, stats.condcands));
+  PRT ("  condpure:      %15" PRId64 "   %10.2f %%  pure autarky", stats.condpure, percent (stats.condpure, stats.conditioned));
   }
   if (all || stats.cover.total) {
   PRT ("covered:         %15" PRId64 "   %10.2f %%  of irredundant clauses", stats.cover.total, percent (stats.cover.total, stats.added.irredundant));
   PRT ("  coverings:     %15" PRId64 "   %10.2f    interval", stats.cover.count, relative (stats.conflicts, stats.cover.count));
   PRT ("  asymmetric:    %15" PRId64 "   %10.2f %%  of covered clauses", stats.cover.asymmetric, percent (stats.cover.asymmetric, stats.cover.total));
   PRT ("  blocked:       %15" PRId64 "   %10.2f %%  of covered clauses", stats.cover.blocked, percent (stats.cover.blocked, stats.cover.total));
+  PRT ("  aborted:       %15" PRId64 "   %10.2f    per covering", stats.cover.aborted, relative (stats.cover.aborted, stats.cover.count));
+  PRT ("  closures:      %15" PRId64 "   %10.2f    per covering", stats.cover.closures, relative (stats.cover.closures, stats.cover.count));
+  PRT ("  cached:        %15" PRId64 "   %10.2f %%  of closures", stats.cover.cached, percent (stats.cover.cached, stats.cover.cached + stats.cover.closures));
   }
   if (all || stats.decisions) {
   PRT ("decisions:       %15" PRId64 "   %10.2f    per second", stats.decisions, relative (stats.decisions, t));
   PRT ("  searched:      %15" PRId64 "   %10.2f    per decision", stats.searched, relative (stats.searched, stats.decisions));
+  PRT ("  lrb:           %15" PRId64 "   %10.2f %%  of decisions", stats.lrbdecisions, percent (stats.lrbdecisions, stats.decisions));
   }
   if (all || stats.all.eliminated) {
   PRT ("eliminated:      %15" PRId64 "   %10.2f %%  of all variables", stats.all.eliminated, percent (stats.all.eliminated, stats.vars));
@@ -108,9 +133,11 @@ void Stats::print (Internal * internal) {
   PRT ("  elimands:      %15" PRId64 "   %10.2f %%  and gates", stats.elimands, percent (stats.elimands, stats.elimgates));
   PRT ("  elimites:      %15" PRId64 "   %10.2f %%  if-then-else gates", stats.elimites, percent (stats.elimites, stats.elimgates));
   PRT ("  elimxors:      %15" PRId64 "   %10.2f %%  xor gates", stats.elimxors, percent (stats.elimxors, stats.elimgates));
+  PRT ("  elimdefs:      %15" PRId64 "   %10.2f %%  definitions", stats.elimdefs, percent (stats.elimdefs, stats.elimgates));
   PRT ("  elimsubst:     %15" PRId64 "   %10.2f %%  substituted", stats.elimsubst, percent (stats.elimsubst, stats.all.eliminated));
   PRT ("  elimres:       %15" PRId64 "   %10.2f    per eliminated", stats.elimres, relative (stats.elimres, stats.all.eliminated));
   PRT ("  elimrestried:  %15" PRId64 "   %10.2f %%  per resolution", stats.elimrestried, percent (stats.elimrestried, stats.elimres));
+  PRT ("  elimcounted:   %15" PRId64 "   %10.2f %%  per resolution", stats.elimcounted, percent (stats.elimcounted, stats.elimres));
   }
   if (all || stats.all.fixed) {
   PRT ("fixed:           %15" PRId64 "   %10.2f %%  of all variables", stats.all.fixed, percent (stats.all.fixed, stats.vars));
@@ -121,6 +148,7 @@ void Stats::print (Internal * internal) {
   PRT ("  probesuccess:  %15" PRId64 "   %10.2f %%  phases", stats.probesuccess, percent (stats.probesuccess, stats.probingphases));
   PRT ("  probingrounds: %15" PRId64 "   %10.2f    per phase", stats.probingrounds, relative (stats.probingrounds, stats.probingphases));
   PRT ("  probed:        %15" PRId64 "   %10.2f    per failed", stats.probed, relative (stats.probed, stats.failed));
+  PRT ("  probetree:     %15" PRId64 "   %10.2f %%  per probed", stats.probetree, percent (stats.probetree, stats.probed));
   PRT ("  hbrs:          %15" PRId64 "   %10.2f    per probed", stats.hbrs, relative (stats.hbrs, stats.probed));
   PRT ("  hbrsizes:      %15" PRId64 "   %10.2f    per hbr", stats.hbrsizes, relative (stats.hbrsizes, stats.hbrs));
   PRT ("  hbreds:        %15" PRId64 "   %10.2f %%  per hbr", stats.hbreds, percent (stats.hbreds, stats.hbrs));
@@ -133,6 +161,14 @@ void Stats::print (Internal * internal) {
   PRT ("  hyper:         %15" PRId64 "   %10.2f %%  per conflict", stats.flush.hyper, relative (stats.flush.hyper, stats.conflicts));
   PRT ("  flushings:     %15" PRId64 "   %10.2f    interval", stats.flush.count, relative (stats.conflicts, stats.flush.count));
   }
+  if (all || stats.gaussxors) {
+  PRT ("gauss:           %15" PRId64 "   %10.2f    XORs per phase", stats.gaussxors, relative (stats.gaussxors, stats.gauss));
+  PRT ("  phases:        %15" PRId64 "   %10.2f    interval", stats.gauss, relative (stats.conflicts, stats.gauss));
+  PRT ("  units:         %15" PRId64 "   %10.2f %%  of all variables", stats.gaussunits, percent (stats.gaussunits, stats.vars));
+  PRT ("  equivs:        %15" PRId64 "   %10.2f %%  of all variables", stats.gaussequivs, percent (stats.gaussequivs, stats.vars));
+  }
+  if (all || stats.heapified)
+  PRT ("heapified:       %15" PRId64 "   %10.2f    interval", stats.heapified, relative (stats.conflicts, stats.heapified));
   if (all || stats.instantiated) {
   PRT ("instantiated:    %15" PRId64 "   %10.2f %%  of tried", stats.instantiated, percent (stats.instantiated, stats.instried));
   PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds", stats.instrounds, percent (stats.instrounds, stats.elimrounds));
@@ -145,6 +181,9 @@ void Stats::print (Internal * internal) {
   PRT ("  promoted2:     %15" PRId64 "   %10.2f %%  per learned", stats.promoted2, percent (stats.promoted2, stats.learned.clauses));
   PRT ("  improvedglue:  %15" PRId64 "   %10.2f %%  per learned", stats.improvedglue, percent (stats.improvedglue, stats.learned.clauses));
   }
+  if (all || stats.lookups) {
+  PRT ("lookups:         %15" PRId64 "   %10.2f %%  found", stats.lookups, percent (stats.lookuphits, stats.lookups));
+  }
   if (all || stats.lucky.succeeded) {
   PRT ("lucky:           %15" PRId64 "   %10.2f %%  of tried", stats.lucky.succeeded, percent (stats.lucky.succeeded, stats.lucky.tried));
   PRT ("  constantzero   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.constant.zero, percent (stats.lucky.constant.zero, stats.lucky.tried));
@@ -156,6 +195,18 @@ void Stats::print (Internal * internal) {
   PRT ("  positivehorn   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.horn.positive, percent (stats.lucky.horn.positive, stats.lucky.tried));
   PRT ("  negativehorn   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.horn.negative, percent (stats.lucky.horn.negative, stats.lucky.tried));
   }
+  if (all && stats.lucky.tried) {
+  const double luckytime = stats.lucky.time.constant.zero + stats.lucky.time.constant.one + stats.lucky.time.backward.one + stats.lucky.time.backward.zero + stats.lucky.time.forward.one + stats.lucky.time.forward.zero + stats.lucky.time.horn.positive + stats.lucky.time.horn.negative;
+  PRT ("luckytime:       %15.2f   %10.2f %%  of solve", luckytime, percent (luckytime, t));
+  PRT ("  constantzero   %15.2f   %10.2f %%  of luckytime", stats.lucky.time.constant.zero, percent (stats.lucky.time.constant.zero, luckytime));
+  PRT ("  constantone    %15.2f   %10.2f %%  of luckytime", stats.lucky.time.constant.one, percent (stats.lucky.time.constant.one, luckytime));
+  PRT ("  backwardone    %15.2f   %10.2f %%  of luckytime", stats.lucky.time.backward.one, percent (stats.lucky.time.backward.one, luckytime));
+  PRT ("  backwardzero   %15.2f   %10.2f %%  of luckytime", stats.lucky.time.backward.zero, percent (stats.lucky.time.backward.zero, luckytime));
+  PRT ("  forwardone     %15.2f   %10.2f %%  of luckytime", stats.lucky.time.forward.one, percent (stats.lucky.time.forward.one, luckytime));
+  PRT ("  forwardzero    %15.2f   %10.2f %%  of luckytime", stats.lucky.time.forward.zero, percent (stats.lucky.time.forward.zero, luckytime));
+  PRT ("  positivehorn   %15.2f   %10.2f %%  of luckytime", stats.lucky.time.horn.positive, percent (stats.lucky.time.horn.positive, luckytime));
+  PRT ("  negativehorn   %15.2f   %10.2f %%  of luckytime", stats.lucky.time.horn.negative, percent (stats.lucky.time.horn.negative, luckytime));
+  }
   PRT ("  extendbytes:   %15zd   %10.2f    bytes and MB", extendbytes, extendbytes/(double)(1l<<20));
   if (all || stats.learned.clauses)
   PRT ("learned_lits:    %15" PRId64 "   %10.2f %%  learned literals", stats.learned.literals, percent (stats.learned.literals, stats.learned.literals));
@@ -177,6 +228,7 @@ void Stats::print (Internal * internal) {
   PRT ("reduced:         %15" PRId64 "   %10.2f %%  per conflict", stats.reduced, percent (stats.reduced, stats.conflicts));
   PRT ("  reductions:    %15" PRId64 "   %10.2f    interval", stats.reductions, relative (stats.conflicts, stats.reductions));
   PRT ("  collections:   %15" PRId64 "   %10.2f    interval", stats.collections, relative (stats.conflicts, stats.collections));
+  PRT ("  activity:      %15" PRId64 "   %10.2f    per conflict", stats.activity, relative (stats.activity, stats.conflicts));
   }
   if (all || stats.rephased.total) {
   PRT ("rephased:        %15" PRId64 "   %10.2f    interval", stats.rephased.total, relative (stats.conflicts, stats.rephased.total));
@@ -213,13 +265,16 @@ void Stats::print (Internal * internal) {
   PRT ("  subsumephases: %15" PRId64 "   %10.2f    interval", stats.subsumephases, relative (stats.conflicts, stats.subsumephases));
   PRT ("  subsumerounds: %15" PRId64 "   %10.2f    per phase", stats.subsumerounds, relative (stats.subsumerounds, stats.subsumephases));
   PRT ("  deduplicated:  %15" PRId64 "   %10.2f %%  per subsumed", stats.deduplicated, percent (stats.deduplicated, stats.subsumed));
+  PRT ("  deduplong:     %15" PRId64 "   %10.2f %%  per subsumed", stats.deduplong, percent (stats.deduplong, stats.subsumed));
   PRT ("  transreds:     %15" PRId64 "   %10.2f    interval", stats.transreds, relative (stats.conflicts, stats.transreds));
   PRT ("  transitive:    %15" PRId64 "   %10.2f %%  per subsumed", stats.transitive, percent (stats.transitive, stats.subsumed));
+  PRT ("  transbatches:  %15" PRId64 "   %10.2f    per transred", stats.transbatches, relative (stats.transbatches, stats.transreds));
   PRT ("  subirr:        %15" PRId64 "   %10.2f %%  of subsumed", stats.subirr, percent (stats.subirr, stats.subsumed));
   PRT ("  subred:        %15" PRId64 "   %10.2f %%  of subsumed", stats.subred, percent (stats.subred, stats.subsumed));
   PRT ("  subtried:      %15" PRId64 "   %10.2f    tried per subsumed", stats.subtried, relative (stats.subtried, stats.subsumed));
   PRT ("  subchecks:     %15" PRId64 "   %10.2f    per tried", stats.subchecks, relative (stats.subchecks, stats.subtried));
   PRT ("  subchecks2:    %15" PRId64 "   %10.2f %%  per subcheck", stats.subchecks2, percent (stats.subchecks2, stats.subchecks));
+  PRT ("  subsigs:       %15" PRId64 "   %10.2f    per tried", stats.subsigs, relative (stats.subsigs, stats.subtried));
   PRT ("  elimotfsub:    %15" PRId64 "   %10.2f %%  of subsumed", stats.elimotfsub, percent (stats.elimotfsub, stats.subsumed));
   PRT ("  elimbwsub:     %15" PRId64 "   %10.2f %%  of subsumed", stats.elimbwsub, percent (stats.elimbwsub, stats.subsumed));
   PRT ("  eagersub:      %15" PRId64 "   %10.2f %%  of subsumed", stats.eagersub, percent (stats.eagersub, stats.subsumed));
@@ -241,7 +296,13 @@ void Stats::print (Internal * internal) {
   PRT ("  vivifications: %15" PRId64 "   %10.2f    interval", stats.vivifications, relative (stats.conflicts, stats.vivifications));
   PRT ("  vivifychecks:  %15" PRId64 "   %10.2f %%  per conflict", stats.vivifychecks, percent (stats.vivifychecks, stats.conflicts));
   PRT ("  vivifysched:   %15" PRId64 "   %10.2f %%  checks per scheduled", stats.vivifysched, percent (stats.vivifychecks, stats.vivifysched));
+  PRT ("  vivifyrebuilt: %15" PRId64 "   %10.2f %%  per round", stats.vivifyrebuilt, percent (stats.vivifyrebuilt, stats.vivifyrebuilt + stats.vivifymerged));
+  PRT ("  vivifymerged:  %15" PRId64 "   %10.2f %%  per round", stats.vivifymerged, percent (stats.vivifymerged, stats.vivifyrebuilt + stats.vivifymerged));
   PRT ("  vivifyunits:   %15" PRId64 "   %10.2f %%  per vivify check", stats.vivifyunits, percent (stats.vivifyunits, stats.vivifychecks));
+  PRT ("  vivifyused:    %15" PRId64 "   %10.2f %%  per vivify check", stats.vivifyused, percent (stats.vivifyused, stats.vivifychecks));
+  PRT ("  vivifytier2:   %15" PRId64 "   %10.2f %%  per vivify check", stats.vivifytier2, percent (stats.vivifytier2, stats.vivifychecks));
+  PRT ("  vivifyretier:  %15" PRId64 "   %10.2f %%  per scheduled", stats.vivifyretier, percent (stats.vivifyretier, stats.vivifysched));
+  PRT ("  vivifytier3:   %15" PRId64 "   %10.2f %%  per vivify check", stats.vivifytier3, percent (stats.vivifytier3, stats.vivifychecks));
   PRT ("  vivifysubs:    %15" PRId64 "   %10.2f %%  per subsumed", stats.vivifysubs, percent (stats.vivifysubs, stats.subsumed));
   PRT ("  vivifystrs:    %15" PRId64 "   %10.2f %%  per strengthened", stats.vivifystrs, percent (stats.vivifystrs, stats.strengthened));
   PRT ("  vivifystrirr:  %15" PRId64 "   %10.2f %%  per vivifystrs", stats.vivifystrirr, percent (stats.vivifystrirr, stats.vivifystrs));
@@ -263,11 +324,23 @@ void Stats::print (Internal * internal) {
   PRT ("  minimum:       %15" PRId64 "   %10.2f %%  clauses", stats.walk.minimum, percent (stats.walk.minimum, stats.added.irredundant));
   PRT ("  broken:        %15" PRId64 "   %10.2f    per flip", stats.walk.broken, relative (stats.walk.broken, stats.walk.flips));
   }
+  if (all || stats.walkthreads) {
+  PRT ("walkthreads:     %15" PRId64 "   %10.2f    interval", stats.walkthreads, relative (stats.conflicts, stats.walkthreads));
+  PRT ("  flips:         %15" PRId64 "   %10.2f    per thread", stats.walkthreadflips, relative (stats.walkthreadflips, stats.walkthreads));
+  PRT ("  imported:      %15" PRId64 "   %10.2f %%  per rephasedwalk", stats.walkthreadimports, percent (stats.walkthreadimports, stats.rephased.walk));
+  }
   if (all || stats.weakened) {
   PRT ("weakened:        %15" PRId64 "   %10.2f    average size", stats.weakened, relative (stats.weakenedlen, stats.weakened));
   PRT ("  extensions:    %15" PRId64 "   %10.2f    interval", stats.extensions, relative (stats.conflicts, stats.extensions));
   PRT ("  flipped:       %15" PRId64 "   %10.2f    per weakened", stats.extended, relative (stats.extended, stats.weakened));
   }
+  if (all || stats.xors) {
+  PRT ("xors:            %15" PRId64 "   %10.2f    per phase", stats.xors, relative (stats.xors, stats.xorphases));
+  PRT ("  phases:        %15" PRId64 "   %10.2f    interval", stats.xorphases, relative (stats.conflicts, stats.xorphases));
+  PRT ("  clauses:       %15" PRId64 "   %10.2f    per XOR", stats.xorclauses, relative (stats.xorclauses, stats.xors));
+  PRT ("  explanations:  %15" PRId64 "   %10.2f %%  per conflict", stats.xorexpls, percent (stats.xorexpls, stats.conflicts));
+  PRT ("  resets:        %15" PRId64 "   %10.2f    interval", stats.xorresets, relative (stats.conflicts, stats.xorresets));
+  }
 
   LINE ();
   MSG ("%sseconds are measured in %s time for solving%s",
@@ -38,9 +38,11 @@ struct Stats {
   int64_t conditioned;  // globally blocked clauses eliminated
   int64_t conditionings;// globally blocked clause eliminations
   int64_t condprops;    // propagated unassigned literals
+  int64_t condpure;     // globally blocked by pure autarky
 
   struct {
     int64_t block;      // block marked literals
+    int64_t decompose;  // decompose marked variables
     int64_t elim;       // elim marked variables
     int64_t subsume;    // subsume marked variables
     int64_t ternary;    // ternary marked variables
@@ -59,6 +61,9 @@ struct Stats {
     int64_t asymmetric; // number of asymmetric tautologies in CCE
     int64_t blocked;    // number of blocked covered tautologies
     int64_t total;      // total number of eliminated clauses
+    int64_t aborted;    // candidates with too large extended clause
+    int64_t closures;   // computed binary implication closures
+    int64_t cached;     // reused binary implication closures
   } cover;
 
   struct {
@@ -66,6 +71,10 @@ struct Stats {
     int64_t succeeded;
     struct { int64_t one, zero; } constant, forward, backward;
     struct { int64_t positive, negative; } horn;
+    struct {            // real time spent per strategy
+      struct { double one, zero; } constant, forward, backward;
+      struct { double positive, negative; } horn;
+    } time;
   } lucky;
 
   struct {
@@ -99,6 +108,7 @@ struct Stats {
   int64_t stabphases;   // number of stabilization phases
   int64_t stabconflicts;// number of search conflicts during stabilizing
   int64_t rescored;     // number of times scores were rescored
+  int64_t heapified;    // score heaps rebuilt bottom-up in linear time
   int64_t resets;       // number of times a reset-restart was performed
   int64_t reused;       // number of reused trails
   int64_t reusedlevels; // reused levels at restart
@@ -112,8 +122,10 @@ struct Stats {
   int64_t bumped;       // seen and bumped variables in 'analyze'
   int64_t recomputed;   // recomputed glues 'recompute_glue'
   int64_t searched;     // searched decisions in 'decide'
+  int64_t lrbdecisions; // decisions picked by learning rate branching
   int64_t reductions;   // 'reduce' counter
   int64_t reduced;      // number of reduced clauses
+  int64_t activity;     // clause activity bumps (with 'reduceactivity')
   int64_t collected;    // number of collected bytes
   int64_t collections;  // number of garbage collections
   int64_t hbrs;         // hyper binary resolvents
@@ -126,6 +138,7 @@ struct Stats {
   int64_t subsumed;     // number of subsumed clauses
   int64_t deduplicated; // number of removed duplicated binary clauses
   int64_t deduplications;//number of deduplication phases
+  int64_t deduplong;    // number of removed duplicated long clauses
   int64_t strengthened; // number of strengthened clauses
   int64_t elimotfstr;   // number of on-the-fly strengthened during elimination
   int64_t subirr;       // number of subsumed irredundant clauses
@@ -133,6 +146,7 @@ struct Stats {
   int64_t subtried;     // number of tried subsumptions
   int64_t subchecks;    // number of pair-wise subsumption checks
   int64_t subchecks2;   // same but restricted to binary clauses
+  int64_t subsigs;      // subsumption checks filtered by signatures
   int64_t elimotfsub;   // number of on-the-fly subsumed during elimination
   int64_t subsumerounds;// number of subsumption rounds
   int64_t subsumephases;// number of scheduled subsumption phases
@@ -140,6 +154,7 @@ struct Stats {
   int64_t eagersub;     // number of eagerly subsumed recently learned clauses
   int64_t elimres;      // number of resolved clauses in BVE
   int64_t elimrestried; // number of tried resolved clauses in BVE
+  int64_t elimcounted;  // number of resolvents counted without generating
   int64_t elimrounds;   // number of elimination rounds
   int64_t elimphases;   // number of scheduled elimination phases
   int64_t elimcompleted;// number complete elimination procedures
@@ -150,19 +165,38 @@ struct Stats {
   int64_t elimands;     // number of AND gates found during elimination
   int64_t elimites;     // number of ITE gates found during elimination
   int64_t elimxors;     // number of XOR gates found during elimination
+  int64_t elimdefs;     // number of definitions mined during elimination
   int64_t elimbwsub;    // number of eager backward subsumed clauses
   int64_t elimbwstr;    // number of eager backward strengthened clauses
+  int64_t amophases;    // number of AMO detection phases
+  int64_t amos;         // number of detected at-most-one constraints
+  int64_t amobins;      // number of binary clauses replaced by AMOs
+  int64_t amoexpls;     // number of explained AMO assignments
+  int64_t amoresets;    // number of times AMO constraints were dropped
+  int64_t gauss;        // number of Gaussian elimination phases
+  int64_t gaussxors;    // number of eliminated XORs
+  int64_t gaussunits;   // number of units derived by Gaussian elimination
+  int64_t gaussequivs;  // number of equivalences derived by Gaussian elim.
+  int64_t xorphases;    // number of XOR detection phases
+  int64_t xors;         // number of native XOR constraints
+  int64_t xorclauses;   // number of clauses replaced by native XORs
+  int64_t xorexpls;     // number of explained XOR assignments
+  int64_t xorresets;    // number of times XOR constraints were dropped
   int64_t ternary;      // number of ternary resolution phases
   int64_t ternres;      // number of ternary resolutions
   int64_t htrs;         // number of hyper ternary resolvents
   int64_t htrs2;        // number of binary hyper ternary resolvents
   int64_t htrs3;        // number of ternary hyper ternary resolvents
+  int64_t lookups;      // number of clause lookups in hash tables
+  int64_t lookuphits;   // number of clauses found by lookups
   int64_t decompositions; // number of SCC + ELS
   int64_t vivifications;  // number of vivifications
   int64_t vivifychecks; // checked clauses during vivification
   int64_t vivifydecs;   // vivification decisions
   int64_t vivifyreused; // reused vivification decisions
   int64_t vivifysched;  // scheduled clauses for vivification
+  int64_t vivifyrebuilt; // rebuilt vivification schedules
+  int64_t vivifymerged; // vivification schedules merged incrementally
   int64_t vivifysubs;   // subsumed clauses during vivification
   int64_t vivifystrs;   // strengthened clauses during vivification
   int64_t vivifystrirr; // strengthened irredundant clause
@@ -170,8 +204,16 @@ struct Stats {
   int64_t vivifystred2; // strengthened redundant clause (2)
   int64_t vivifystred3; // strengthened redundant clause (3)
   int64_t vivifyunits;  // units during vivification
+  int64_t vivifyused;   // checked clauses used since last 'reduce'
+  int64_t vivifytier2;  // checked tier two redundant clauses
+  int64_t vivifyretier; // scheduled clauses which changed their tier
+  int64_t vivifytier3;  // checked tier three redundant clauses
   int64_t transreds;
   int64_t transitive;
+  int64_t transbatches; // bit-parallel batches of transitive reduction
+  int64_t walkthreads;  // started background local search threads
+  int64_t walkthreadflips;   // flips in background local search
+  int64_t walkthreadimports; // imported background local search phases
   struct {
     int64_t literals;
     int64_t clauses;
@@ -188,6 +230,7 @@ struct Stats {
   int64_t probingrounds;// number of probing rounds
   int64_t probesuccess; // number successful probing phases
   int64_t probed;       // number of probed literals
+  int64_t probetree;    // number of nested probes in tree based probing
   int64_t failed;       // number of failed literals
   int64_t hyperunary;   // hyper unary resolved unit clauses
   int64_t probefailed;  // failed literals from probing
@@ -225,6 +268,21 @@ struct Stats {
     int64_t delayed;
   } bcprl;
 
+  struct {
+    int64_t full;       // resets randomizing all scores
+    int64_t decay;      // resets decaying scores towards mean
+    int64_t topk;       // resets randomizing top scores
+    int64_t noise;      // resets perturbing scores
+  } resetrl;
+
+  struct {
+    int64_t segments;   // number of selected restart policy segments
+    int64_t glue;       // segments with Glucose style restarts
+    int64_t luby;       // segments with Luby restarts
+    int64_t geometric;  // segments with geometric restarts
+    int64_t none;       // segments without restarts
+  } restartrl;
+
   Stats ();
 
   void print (Internal *);
@@ -130,6 +130,21 @@ inline int Internal::subsume_check (Clause * subsuming, Clause * subsumed)
 
 /*------------------------------------------------------------------------*/
 
+// Connected clauses store their signature in the one-watch occurrence
+// lists, such that most clauses which can neither subsume nor strengthen
+// the candidate are filtered out without touching their literals.  If
+// strengthening is enabled we have to use variable signatures, since one
+// literal is allowed to occur in opposite phase.  Disabling signatures is
+// simulated by returning an empty signature, which never filters.
+
+inline uint64_t Internal::subsume_signature (Clause * c) {
+  if (!opts.subsumesig) return 0;
+  if (opts.subsumestr) return variable_signature (c);
+  return literal_signature (c);
+}
+
+/*------------------------------------------------------------------------*/
+
 // Candidate clause 'subsumed' is subsumed by 'subsuming'.
 
 inline void
@@ -168,6 +183,7 @@ void Internal::strengthen_clause (Clause * c, int lit) {
   c->used = true;
   LOG (c, "strengthened");
   external->check_shrunken_clause (c);
+  add_vivification_candidate (c);
 }
 
 /*------------------------------------------------------------------------*/
@@ -187,6 +203,11 @@ Internal::try_to_subsume_clause (Clause * c, vector<Clause *> & shrunken) {
 
   mark (c);     // signed!
 
+  // Bits in the signature of connected clauses which are not set in the
+  // signature of the candidate rule out subsumption and strengthening.
+  //
+  const uint64_t filter = ~subsume_signature (c);
+
   Clause dummy; // Communicate binary subsuming clause.
 
   Clause * d = 0;
@@ -245,8 +266,10 @@ Internal::try_to_subsume_clause (Clause * c, vector<Clause *> & shrunken) {
       // as above for communicating 'subsumption' or 'strengthening' to the
       // code after the loop is used.
       //
-      const Occs & os = occs (sign * lit);
-      for (const auto & e : os) {
+      const SigOccs & os = sigoccs (sign * lit);
+      for (const auto & o : os) {
+        if (o.sig & filter) { stats.subsigs++; continue; }
+        Clause * e = o.clause;
         assert (!e->garbage);                   // sanity check
         if (e->garbage) continue;               // defensive: not needed
         flipped = subsume_check (e, c);
@@ -280,6 +303,309 @@ Internal::try_to_subsume_clause (Clause * c, vector<Clause *> & shrunken) {
 
 /*------------------------------------------------------------------------*/
 
+// With 'opts.subsumethreads > 1' the scheduled clauses are processed in
+// batches.  First worker threads check all candidates of a batch in
+// parallel against the occurrence lists as they are at the start of the
+// batch ('frozen').  Then the results are committed sequentially in the
+// original order, which additionally requires to check the candidates
+// against the clauses connected during the current batch.  Only those
+// have to be checked which come before the hit of the worker in the order
+// in which the sequential algorithm traverses the occurrence lists, i.e.,
+// first by position of the literal in the candidate, then by sign and
+// finally binary clauses before larger clauses.  This 'key' order makes
+// the result and also the counted effort identical to the sequential
+// algorithm, independent of the number of threads.
+
+struct SubsumeResult {
+  Clause * clause;      // subsuming clause (zero for binary clauses)
+  int binary[2];        // literals of binary subsuming clause
+  int flipped;          // as in 'try_to_subsume_clause'
+  unsigned key;         // position of hit in sequential traversal order
+  int64_t checks;       // number of subsumption checks until hit
+  int64_t checks2;      // number of those on binary clauses
+  int64_t sigs;         // number of clauses filtered by signatures
+};
+
+struct Subsumer {
+
+  const unsigned threads;
+  unsigned batch;                       // current batch (stamp)
+
+  size_t begin, end;                    // batch range in schedule
+  vector<Clause *> candidates;          // scheduled clauses of batch
+  vector<SubsumeResult> results;        // aligned with 'candidates'
+
+  vector<vector<signed char>> marks;    // thread local candidate marks
+
+  vector<unsigned> stamps;              // batch when list was extended
+  vector<size_t> frozen;                // list size at start of batch
+
+  Subsumer (unsigned t) : threads (t), batch (0), begin (0), end (0) { }
+
+  void init (int max_var) {
+    marks.resize (threads);
+    for (auto & m : marks)
+      m.resize (max_var + 1, 0);
+    const size_t lists = 4 * (size_t) (max_var + 1);
+    stamps.resize (lists, 0);
+    frozen.resize (lists);
+  }
+
+  // Lists are indexed by '2*vlit(lit)' for binary clause lists 'bins' and
+  // by '2*vlit(lit)+1' for the one-watch lists 'sigoccs'.
+
+  size_t frozen_size (unsigned list, size_t size) const {
+    return stamps[list] == batch ? frozen[list] : size;
+  }
+
+  void freeze (unsigned list, size_t size) {
+    if (stamps[list] == batch) return;
+    stamps[list] = batch;
+    frozen[list] = size;
+  }
+};
+
+// Same as 'subsume_check' but with thread local marks and without moving
+// the failing literal to the front, since workers only read clauses.
+
+static int
+subsume_check_marks (Clause * subsuming, const vector<signed char> & marks,
+                     bool strengthen)
+{
+  int flipped = 0;
+  for (const auto & lit : *subsuming) {
+    const int tmp = sign (lit) * marks[abs (lit)];
+    if (!tmp) return 0;
+    if (tmp > 0) continue;
+    if (flipped) return 0;
+    flipped = lit;
+  }
+  if (!flipped) return INT_MIN;
+  if (!strengthen) return 0;
+  return flipped;
+}
+
+// Worker 'thread' checks every 'threads' candidate of the batch.  It must
+// neither touch statistics nor the shared marks nor log anything.
+
+void Internal::subsume_worker (Subsumer & subsumer, unsigned thread) {
+
+  vector<signed char> & marks = subsumer.marks[thread];
+  const bool strengthen = opts.subsumestr;
+  const size_t size = subsumer.candidates.size ();
+
+  for (size_t k = thread; k < size; k += subsumer.threads) {
+
+    Clause * c = subsumer.candidates[k];
+    SubsumeResult & r = subsumer.results[k];
+    r.clause = 0;
+    r.flipped = 0;
+    r.key = 0;
+    r.checks = r.checks2 = r.sigs = 0;
+
+    if (c->size <= 2 || !c->subsume) continue;
+
+    for (const auto & lit : *c)
+      marks[abs (lit)] = sign (lit);
+
+    const uint64_t filter = ~subsume_signature (c);
+
+    for (unsigned pos = 0; !r.flipped && pos < (unsigned) c->size; pos++) {
+
+      const int lit = c->literals[pos];
+      if (!flags (lit).subsume) continue;
+
+      for (int sign = -1; !r.flipped && sign <= 1; sign += 2) {
+
+        const unsigned key = 4*pos + 2*(sign > 0);
+
+        for (const auto & other : bins (sign*lit)) {
+          const int tmp = ::CaDiCaL::sign (other) * marks[abs (other)];
+          if (!tmp) continue;
+          if (tmp < 0 && sign < 0) continue;
+          if (tmp < 0) {
+            r.binary[0] = lit;
+            r.binary[1] = other;
+            r.flipped = other;
+          } else {
+            r.binary[0] = sign*lit;
+            r.binary[1] = other;
+            r.flipped = (sign < 0) ? -lit : INT_MIN;
+          }
+          r.key = key;
+          break;
+        }
+
+        if (r.flipped) break;
+
+        for (const auto & o : sigoccs (sign*lit)) {
+          if (o.sig & filter) { r.sigs++; continue; }
+          Clause * e = o.clause;
+          r.checks++;
+          if (e->size == 2) r.checks2++;
+          const int flipped = subsume_check_marks (e, marks, strengthen);
+          if (!flipped) continue;
+          r.clause = e;
+          r.flipped = flipped;
+          r.key = key + 1;
+          break;
+        }
+      }
+    }
+
+    for (const auto & lit : *c)
+      marks[abs (lit)] = 0;
+  }
+}
+
+void Internal::subsume_batch (Subsumer & subsumer) {
+  subsumer.batch++;
+  subsumer.results.resize (subsumer.candidates.size ());
+  run_in_parallel (subsumer.threads, [&] (unsigned thread) {
+    subsume_worker (subsumer, thread);
+  });
+}
+
+// Sequential part for the candidate at position 'k' in the batch, with
+// the same contract as 'try_to_subsume_clause'.
+
+int
+Internal::subsume_commit (Subsumer & subsumer, size_t k,
+                          vector<Clause *> & shrunken)
+{
+  Clause * c = subsumer.candidates[k];
+  const SubsumeResult & r = subsumer.results[k];
+
+  stats.subtried++;
+  assert (!level);
+  LOG (c, "trying to subsume");
+
+  mark (c);
+
+  const uint64_t filter = ~subsume_signature (c);
+
+  Clause dummy;
+  dummy.redundant = false;
+  dummy.size = 2;
+
+  Clause * d = 0;
+  int flipped = 0;
+  unsigned key = 0;
+
+  // Check clauses connected during this batch in traversal order up to
+  // the hit of the worker (if any).
+  //
+  for (unsigned pos = 0; pos < (unsigned) c->size; pos++) {
+
+    const int lit = c->literals[pos];
+    if (!flags (lit).subsume) continue;
+
+    for (int sign = -1; sign <= 1; sign += 2) {
+
+      key = 4*pos + 2*(sign > 0);
+      if (r.flipped && key >= r.key) goto DONE;
+
+      const unsigned list = 2*vlit (sign*lit);
+      const auto & bs = bins (sign*lit);
+      const size_t bfrozen = subsumer.frozen_size (list, bs.size ());
+      for (auto i = bs.begin () + bfrozen; i != bs.end (); i++) {
+        const int other = *i;
+        const int tmp = marked (other);
+        if (!tmp) continue;
+        if (tmp < 0 && sign < 0) continue;
+        if (tmp < 0) {
+          dummy.literals[0] = lit;
+          dummy.literals[1] = other;
+          flipped = other;
+        } else {
+          dummy.literals[0] = sign*lit;
+          dummy.literals[1] = other;
+          flipped = (sign < 0) ? -lit : INT_MIN;
+        }
+        d = &dummy;
+        goto DONE;
+      }
+
+      key++;
+      if (r.flipped && key >= r.key) goto DONE;
+
+      const SigOccs & os = sigoccs (sign*lit);
+      const size_t ofrozen = subsumer.frozen_size (list + 1, os.size ());
+      for (auto i = os.begin () + ofrozen; i != os.end (); i++) {
+        if (i->sig & filter) { stats.subsigs++; continue; }
+        Clause * e = i->clause;
+        assert (!e->garbage);
+        flipped = subsume_check (e, c);
+        if (!flipped) continue;
+        d = e;
+        goto DONE;
+      }
+    }
+  }
+
+DONE:
+
+  if (d) {
+
+    // A clause connected in this batch comes first, so recount the effort
+    // the sequential algorithm spends on the frozen lists before.
+    //
+    bool recounted = false;
+    for (unsigned pos = 0; !recounted && pos < (unsigned) c->size; pos++) {
+      const int lit = c->literals[pos];
+      if (!flags (lit).subsume) continue;
+      for (int sign = -1; !recounted && sign <= 1; sign += 2) {
+        const unsigned tmp = 4*pos + 2*(sign > 0) + 1;
+        if (tmp > key) { recounted = true; continue; }
+        const unsigned list = 2*vlit (sign*lit) + 1;
+        const SigOccs & os = sigoccs (sign*lit);
+        const size_t ofrozen = subsumer.frozen_size (list, os.size ());
+        for (auto i = os.begin (); i != os.begin () + ofrozen; i++) {
+          if (i->sig & filter) { stats.subsigs++; continue; }
+          stats.subchecks++;
+          if (i->clause->size == 2) stats.subchecks2++;
+        }
+      }
+    }
+
+  } else {
+
+    stats.subchecks += r.checks;
+    stats.subchecks2 += r.checks2;
+    stats.subsigs += r.sigs;
+
+    if (r.flipped) {
+      flipped = r.flipped;
+      if (r.clause) d = r.clause;
+      else {
+        dummy.literals[0] = r.binary[0];
+        dummy.literals[1] = r.binary[1];
+        d = &dummy;
+      }
+    }
+  }
+
+  unmark (c);
+
+  if (flipped == INT_MIN) {
+    LOG (d, "subsuming");
+    subsume_clause (d, c);
+    return 1;
+  }
+
+  if (flipped) {
+    LOG (d, "strengthening");
+    strengthen_clause (c, -flipped);
+    assert (likely_to_be_kept_clause (c));
+    shrunken.push_back (c);
+    return -1;
+  }
+
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Sorting the scheduled clauses is way faster if we compute and save the
 // clause size in the schedule to avoid pointer access to clauses during
 // sorting.  This slightly increases the schedule size though.
@@ -427,17 +753,30 @@ bool Internal::subsume_round () {
   int64_t subsumed = 0, strengthened = 0, checked = 0;
 
   vector<Clause *> shrunken;
-  init_occs ();
+  init_sigoccs ();
   init_bins ();
 
-  for (const auto & s : schedule) {
+  Subsumer subsumer (opts.subsumethreads);
+  if (subsumer.threads > 1) subsumer.init (max_var);
+
+  for (size_t idx = 0; idx < schedule.size (); idx++) {
 
     if (terminated_asynchronously ()) break;
     if (stats.subchecks >= check_limit) break;
 
-    Clause * c = s.clause;
+    Clause * c = schedule[idx].clause;
     assert (!c->garbage);
 
+    if (subsumer.threads > 1 && idx == subsumer.end) {
+      const size_t size = 1024 * (size_t) subsumer.threads;
+      subsumer.begin = idx;
+      subsumer.end = min (schedule.size (), idx + size);
+      subsumer.candidates.clear ();
+      for (size_t i = subsumer.begin; i != subsumer.end; i++)
+        subsumer.candidates.push_back (schedule[i].clause);
+      subsume_batch (subsumer);
+    }
+
     checked++;
 
     // First try to subsume or strengthen this candidate clause.  For binary
@@ -450,7 +789,9 @@ bool Internal::subsume_round () {
     //
     if (c->size > 2 && c->subsume) {
       c->subsume = false;
-      const int tmp = try_to_subsume_clause (c, shrunken);
+      const int tmp = subsumer.threads > 1 ?
+        subsume_commit (subsumer, idx - subsumer.begin, shrunken) :
+        try_to_subsume_clause (c, shrunken);
       if (tmp > 0) { subsumed++; continue; }
       if (tmp < 0) strengthened++;
     }
@@ -471,7 +812,7 @@ bool Internal::subsume_round () {
     for (const auto & lit : *c) {
 
       if (!flags (lit).subsume) subsume = false;
-      const size_t size = binary ? bins (lit).size () : occs (lit).size ();
+      const size_t size = binary ? bins (lit).size () : sigoccs (lit).size ();
       if (minlit && minsize <= size) continue;
       const int64_t tmp = noccs (lit);
       if (minlit && minsize == size && tmp <= minoccs) continue;
@@ -494,7 +835,9 @@ bool Internal::subsume_round () {
       LOG (c, "watching %d with %zd current and total %" PRId64 " occurrences",
         minlit, minsize, minoccs);
 
-      occs (minlit).push_back (c);
+      if (subsumer.threads > 1)
+        subsumer.freeze (2*vlit (minlit) + 1, minsize);
+      sigoccs (minlit).push_back (SigOcc (subsume_signature (c), c));
 
       // This sorting should give faster failures for assumption checks
       // since the less occurring variables are put first in a clause and
@@ -519,6 +862,8 @@ bool Internal::subsume_round () {
 
       const int minlit_pos = (c->literals[1] == minlit);
       const int other = c->literals[!minlit_pos];
+      if (subsumer.threads > 1)
+        subsumer.freeze (2*vlit (minlit), minsize);
       bins (minlit).push_back (other);
     }
   }
@@ -544,7 +889,7 @@ bool Internal::subsume_round () {
   //
   erase_vector (schedule);
   reset_noccs ();
-  reset_occs ();
+  reset_sigoccs ();
   reset_bins ();
 
   // Reset all old 'added' flags and mark variables in shrunken
@@ -568,6 +913,8 @@ bool Internal::subsume_round () {
 
 void Internal::subsume (bool update_limits) {
 
+  reset_amos ();
+  reset_xors ();
   stats.subsumephases++;
 
   if (!stats.current.redundant && !stats.current.irredundant)
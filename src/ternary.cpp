@@ -20,24 +20,16 @@ namespace CaDiCaL {
 /*------------------------------------------------------------------------*/
 
 // Check whether a binary clause consisting of the permutation of the given
-// literals already exists.
+// literals already exists.  This is a hash table lookup (see 'lookup.cpp')
+// and thus independent of the number of occurrences of the literals.
 
 bool
-Internal::ternary_find_binary_clause (int a, int b) {
+Internal::ternary_find_binary_clause (Lookup & lookup, int a, int b) {
   assert (occurring ());
   assert (active (a));
   assert (active (b));
-  size_t s = occs (a).size ();
-  size_t t = occs (b).size ();
-  int lit = s < t ? a : b;
-  if (opts.ternaryocclim < (int) occs (lit).size ()) return true;
-  for (const auto & c : occs (lit)) {
-    if (c->size != 2) continue;
-    const int * lits = c->literals;
-    if (lits[0] == a && lits[1] == b) return true;
-    if (lits[0] == b && lits[1] == a) return true;
-  }
-  return false;
+  const int lits[2] = { a, b };
+  return lookup_clause (lookup, lits, 2);
 }
 
 /*------------------------------------------------------------------------*/
@@ -46,38 +38,16 @@ Internal::ternary_find_binary_clause (int a, int b) {
 // literals  already exists or is subsumed by an existing binary clause.
 
 bool
-Internal::ternary_find_ternary_clause (int a, int b, int c) {
+Internal::ternary_find_ternary_clause (Lookup & lookup, int a, int b, int c) {
   assert (occurring ());
   assert (active (a));
   assert (active (b));
   assert (active (c));
-  size_t r = occs (a).size ();
-  size_t s = occs (b).size ();
-  size_t t = occs (c).size ();
-  int lit;
-  if (r < s) lit = (t < r) ? c : a;
-  else       lit = (t < s) ? c : b;
-  if (opts.ternaryocclim < (int) occs (lit).size ()) return true;
-  for (const auto & d : occs (lit)) {
-    const int * lits = d->literals;
-    if (d->size == 2) {
-      if (lits[0] == a && lits[1] == b) return true;
-      if (lits[0] == b && lits[1] == a) return true;
-      if (lits[0] == a && lits[1] == c) return true;
-      if (lits[0] == c && lits[1] == a) return true;
-      if (lits[0] == b && lits[1] == c) return true;
-      if (lits[0] == c && lits[1] == b) return true;
-    } else {
-      assert (d->size == 3);
-      if (lits[0] == a && lits[1] == b && lits[2] == c) return true;
-      if (lits[0] == a && lits[1] == c && lits[2] == b) return true;
-      if (lits[0] == b && lits[1] == a && lits[2] == c) return true;
-      if (lits[0] == b && lits[1] == c && lits[2] == a) return true;
-      if (lits[0] == c && lits[1] == a && lits[2] == b) return true;
-      if (lits[0] == c && lits[1] == b && lits[2] == a) return true;
-    }
-  }
-  return false;
+  const int lits[3] = { a, b, c };
+  if (lookup_clause (lookup, lits, 3)) return true;
+  if (ternary_find_binary_clause (lookup, a, b)) return true;
+  if (ternary_find_binary_clause (lookup, a, c)) return true;
+  return ternary_find_binary_clause (lookup, b, c);
 }
 
 /*------------------------------------------------------------------------*/
@@ -90,7 +60,8 @@ Internal::ternary_find_ternary_clause (int a, int b, int c) {
 // needs to be cleared in any case.
 
 bool
-Internal::hyper_ternary_resolve (Clause * c, int pivot, Clause * d) {
+Internal::hyper_ternary_resolve (Lookup & lookup,
+                                  Clause * c, int pivot, Clause * d) {
   LOG ("hyper binary resolving on pivot %d", pivot);
   LOG (c, "1st antecedent");
   LOG (d, "2nd antecedent");
@@ -112,10 +83,11 @@ Internal::hyper_ternary_resolve (Clause * c, int pivot, Clause * d) {
   size_t size = clause.size ();
   if (size > 3) return false;
   if (size == 2 &&
-      ternary_find_binary_clause (clause[0], clause[1]))
+      ternary_find_binary_clause (lookup, clause[0], clause[1]))
     return  false;
   if (size == 3 &&
-      ternary_find_ternary_clause (clause[0], clause[1], clause[2]))
+      ternary_find_ternary_clause (lookup,
+        clause[0], clause[1], clause[2]))
     return  false;
   return true;
 }
@@ -128,7 +100,8 @@ Internal::hyper_ternary_resolve (Clause * c, int pivot, Clause * d) {
 // the effort spent in 'ternary' is that it should be similar to one
 // propagation step during search.
 
-void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
+void Internal::ternary_lit (Lookup & lookup, int pivot,
+                            int64_t & steps, int64_t & htrs) {
   LOG ("starting hyper ternary resolutions on pivot %d", pivot);
   for (const auto & c : occs (pivot)) {
     if (htrs < 0) break;
@@ -148,7 +121,7 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
       if (assigned) continue;
       assert (clause.empty ());
       htrs--;
-      if (hyper_ternary_resolve (c, pivot, d)) {
+      if (hyper_ternary_resolve (lookup, c, pivot, d)) {
         size_t size = clause.size ();
         bool red = (size == 3 || (c->redundant && d->redundant));
         Clause * r = new_hyper_ternary_resolved_clause (red);
@@ -158,6 +131,7 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
         stats.htrs++;
         for (const auto & lit : *r)
           occs (lit).push_back (r);
+        lookup_insert (lookup, r);
         if (size == 2) {
           LOG ("hyper ternary resolvent subsumes both antecedents");
           mark_garbage (c);
@@ -181,7 +155,8 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
 // Same as 'ternary_lit' but pick the phase of the variable based on the
 // number of positive and negative occurrence.
 
-void Internal::ternary_idx (int idx, int64_t & steps, int64_t & htrs) {
+void Internal::ternary_idx (Lookup & lookup, int idx,
+                            int64_t & steps, int64_t & htrs) {
   assert (0 < idx);
   assert (idx <= max_var);
   if (!active (idx)) return;
@@ -192,7 +167,7 @@ void Internal::ternary_idx (int idx, int64_t & steps, int64_t & htrs) {
     LOG ("index %d has %zd positive and %zd negative occurrences",
        idx, occs (idx).size (), occs (-idx).size ());
     int pivot = (neg < pos ? -idx : idx);
-    ternary_lit (pivot, steps, htrs);
+    ternary_lit (lookup, pivot, steps, htrs);
   }
   flags (idx).ternary = false;
 }
@@ -216,6 +191,13 @@ bool Internal::ternary_round (int64_t & steps_limit, int64_t & htrs_limit) {
 
   init_occs ();
 
+  // All binary and ternary clauses are added to the hash table used to
+  // check whether resolvents already exist, even ternary clauses which are
+  // not connected since they do not contain a marked variable.
+  //
+  Lookup lookup;
+  init_lookup (lookup, 2, 3);
+
   for (const auto & c : clauses) {
     if (c->garbage) continue;
     if (c->size > 3) continue;
@@ -225,6 +207,7 @@ bool Internal::ternary_round (int64_t & steps_limit, int64_t & htrs_limit) {
       if (flags (lit).ternary) marked = true;
     }
     if (assigned) continue;
+    lookup_insert (lookup, c);
     if (c->size == 2) bincon++;
     else {
       assert (c->size == 3);
@@ -248,7 +231,7 @@ bool Internal::ternary_round (int64_t & steps_limit, int64_t & htrs_limit) {
     if (terminated_asynchronously ()) break;
     if (steps_limit < 0) break;
     if (htrs_limit < 0) break;
-    ternary_idx (idx, steps_limit, htrs_limit);
+    ternary_idx (lookup, idx, steps_limit, htrs_limit);
   }
 
   // Gather some statistics for the verbose messages below and also
@@ -269,6 +252,7 @@ bool Internal::ternary_round (int64_t & steps_limit, int64_t & htrs_limit) {
     PHASE ("ternary", stats.ternary,
       "completed hyper ternary resolution");
 
+  reset_lookup (lookup);
   reset_occs ();
   assert (!unsat);
 
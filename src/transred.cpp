@@ -6,7 +6,8 @@ namespace CaDiCaL {
 // important for hyper binary resolution, which has the risk to produce too
 // many hyper binary resolvents otherwise.  This algorithm only works on
 // binary clauses and is usually pretty fast.  It will also find some failed
-// literals (in the binary implication graph).
+// literals (in the binary implication graph).  The searches for 64
+// candidate clauses are performed at once with bit-parallel propagation.
 
 void Internal::transred () {
 
@@ -63,10 +64,22 @@ void Internal::transred () {
   //
   sort_watches ();
 
-  // This working stack plays the same role as the 'trail' during standard
-  // propagation.
+  // Candidates are checked in batches of up to 64 clauses (one bit per
+  // candidate in a machine word).  All the sources of a batch are
+  // propagated simultaneously over the binary implication graph, where
+  // 'reach[lit]' is the set of candidates (bits) for which 'lit' was
+  // reached and 'pending[lit]' those bits which still have to be propagated
+  // from 'lit'.  A literal is only propagated again if new bits arrive,
+  // which in an acyclic graph (after 'decompose') and breadth-first order
+  // happens rarely.  Thus a batch costs about as much as a single search.
   //
-  vector<int> work;
+  struct Bits { uint64_t reach, pending, tails, targets; };
+  vector<Bits> bits (2 * vsize, Bits {0, 0, 0, 0});
+
+  vector<Clause *> batch;               // candidate clauses of the batch
+  vector<int> sources, targets;         // 'src' and 'dst' of candidates
+  vector<int> work;                     // literals with pending bits
+  vector<int> touched;                  // literals with reach bits
 
   int64_t propagations = 0, units = 0, removed = 0;
 
@@ -75,115 +88,197 @@ void Internal::transred () {
          !terminated_asynchronously () &&
          propagations < limit)
   {
-    Clause * c = *i++;
-
-    // A clause is a candidate for being transitive if it is binary, and not
-    // the result of hyper binary resolution.  The reason for excluding
-    // those, is that they come in large numbers, most of them are reduced
-    // away anyhow and further are non-transitive at the point they are
-    // added (see the code in 'hyper_binary_resolve' in 'prope.cpp' and
-    // also check out our CPAIOR paper on tree-based look ahead).
-    //
-    if (c->garbage) continue;
-    if (c->size != 2) continue;
-    if (c->redundant && c->hyper) continue;
-    if (c->transred) continue;                  // checked before?
-    c->transred = true;                         // marked as checked
+    assert (batch.empty ());
 
-    LOG (c, "checking transitive reduction of");
+    uint64_t irredundant = 0;           // bits of irredundant candidates
 
-    // Find a different path from 'src' to 'dst' in the binary implication
-    // graph, not using 'c'.  Since this is the same as checking whether
-    // there is a path from '-dst' to '-src', we can do the reverse search
-    // if the number of watches of '-dst' is larger than those of 'src'.
-    //
-    int src = -c->literals[0];
-    int dst = c->literals[1];
-    if (val (src) || val (dst)) continue;
-    if (watches (-src).size () < watches (dst).size ()) {
-      int tmp = dst;
-      dst = -src; src = -tmp;
+    while (i != end && batch.size () < 64) {
+
+      Clause * c = *i++;
+
+      // A clause is a candidate for being transitive if it is binary, and
+      // not the result of hyper binary resolution.  The reason for
+      // excluding those, is that they come in large numbers, most of them
+      // are reduced away anyhow and further are non-transitive at the point
+      // they are added (see the code in 'hyper_binary_resolve' in
+      // 'prope.cpp' and also check out our CPAIOR paper on tree-based look
+      // ahead).
+      //
+      if (c->garbage) continue;
+      if (c->size != 2) continue;
+      if (c->redundant && c->hyper) continue;
+      if (c->transred) continue;                // checked before?
+      c->transred = true;                       // marked as checked
+
+      // Find a different path from 'src' to 'dst' in the binary implication
+      // graph, not using 'c'.  Since this is the same as checking whether
+      // there is a path from '-dst' to '-src', we can do the reverse search
+      // if the number of watches of '-dst' is larger than those of 'src'.
+      //
+      int src = -c->literals[0];
+      int dst = c->literals[1];
+      if (val (src) || val (dst)) continue;
+      if (watches (-src).size () < watches (dst).size ()) {
+        int tmp = dst;
+        dst = -src; src = -tmp;
+      }
+
+      LOG (c, "checking transitive reduction from %d to %d of", src, dst);
+
+      const uint64_t bit = (uint64_t) 1 << batch.size ();
+
+      // If the candidate clause is irredundant then we can not use
+      // redundant binary clauses in the implication graph.  See our
+      // inprocessing rules paper, why this restriction is required.
+      //
+      if (!c->redundant) irredundant |= bit;
+
+      // Remember the literals from which the binary clauses of the batch
+      // are traversed in order to skip them during propagation.
+      //
+      bits[vlit (-c->literals[0])].tails |= bit;
+      bits[vlit (-c->literals[1])].tails |= bit;
+      bits[vlit (dst)].targets |= bit;
+
+      Bits & b = bits[vlit (src)];
+      if (!b.reach) touched.push_back (src);
+      if (!b.pending) work.push_back (src);
+      b.reach |= bit;
+      b.pending |= bit;
+
+      batch.push_back (c);
+      sources.push_back (src);
+      targets.push_back (dst);
     }
 
-    LOG ("searching path from %d to %d", src, dst);
+    if (batch.empty ()) break;
+    stats.transbatches++;
 
-    // If the candidate clause is irredundant then we can not use redundant
-    // binary clauses in the implication graph.  See our inprocessing rules
-    // paper, why this restriction is required.
-    //
-    const bool irredundant = !c->redundant;
+    LOG ("transred batch of %zd candidates", batch.size ());
 
-    assert (work.empty ());
-    mark (src);
-    work.push_back (src);
-    LOG ("transred assign %d", src);
+    const uint64_t all = (batch.size () < 64) ?
+      ((uint64_t) 1 << batch.size ()) - 1 : ~(uint64_t) 0;
 
-    bool transitive = false;            // found path from 'src' to 'dst'?
-    bool failed = false;                // 'src' failed literal?
+    uint64_t transitive = 0;            // found path from 'src' to 'dst'
+    uint64_t failed = 0;                // 'src' failed literal
+
+    // Literals in both 'reach[lit]' and 'reach[-lit]' for the same bit
+    // show that the source of that bit is a failed literal.
+    //
+    for (const auto & src : sources)
+      failed |= bits[vlit (src)].reach & bits[vlit (-src)].reach;
 
     size_t j = 0;                       // 'propagated' in BFS
 
-    while (!transitive && !failed && j < work.size ()) {
+    while (j < work.size () && (transitive | failed) != all) {
+
       const int lit = work[j++];
-      assert (marked (lit) > 0);
+      Bits & b = bits[vlit (lit)];
+      const uint64_t todo = b.pending & ~(transitive | failed);
+      b.pending = 0;
+      if (!todo) continue;
+
       LOG ("transred propagating %d", lit);
       propagations++;
+
       const Watches & ws = watches (-lit);
       const const_watch_iterator eow = ws.end ();
-      const_watch_iterator k;
-      for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
+      for (const_watch_iterator k = ws.begin (); k != eow; k++) {
         const Watch & w = *k;
         if (!w.binary ()) break;        // since we sorted watches above
         Clause * d = w.clause;
-        if (d == c) continue;
-        if (irredundant && d->redundant) continue;
         if (d->garbage) continue;
-        const int other = w.blit;
-        if (other == dst) transitive = true;    // 'dst' reached
-        else {
-          const int tmp = marked (other);
-          if (tmp > 0) continue;
-          else if (tmp < 0) {
-            LOG ("found both %d and %d reachable", -other, other);
-            failed = true;
-          } else {
-            mark (other);
-            work.push_back (other);
-            LOG ("transred assign %d", other);
-          }
+
+        uint64_t add = todo;
+
+        // A candidate clause of the batch is only used in the search of
+        // candidates before it in the batch.  Otherwise two candidates
+        // could be found transitive by using each other (for instance if
+        // they are duplicates).  This way the removed clauses of a batch
+        // are implied by the remaining ones (by induction from the last).
+        //
+        if (b.tails) {
+          const auto pos = find (batch.begin (), batch.end (), d);
+          if (pos != batch.end ())
+            add &= ((uint64_t) 1 << (pos - batch.begin ())) - 1;
         }
+
+        if (d->redundant) add &= ~irredundant;
+        const int other = w.blit;
+        Bits & o = bits[vlit (other)];
+        add &= ~o.reach;
+        if (!add) continue;
+
+        if (!o.reach) touched.push_back (other);
+        if (!o.pending) work.push_back (other);
+        o.reach |= add;
+        o.pending |= add;
+
+        transitive |= add & o.targets;                  // 'dst' reached
+        failed |= add & bits[vlit (-other)].reach;      // both reached
       }
+
+      if (propagations >= limit) break;
     }
 
     // Unassign all assigned literals (same as '[bp]acktrack').
     //
-    while (!work.empty ()) {
-      const int lit = work.back ();
-      work.pop_back ();
-      unmark (lit);
+    for (const auto & lit : touched)
+      bits[vlit (lit)] = Bits {0, 0, 0, 0};
+    for (const auto & c : batch) {
+      bits[vlit (-c->literals[0])].tails = 0;
+      bits[vlit (-c->literals[1])].tails = 0;
     }
+    for (const auto & dst : targets)
+      bits[vlit (dst)].targets = 0;
+    touched.clear ();
+    work.clear ();
 
-    if (transitive) {
+    // Transitive clauses are removed first.  Units derived from failed
+    // sources are implied by the formula with or without these clauses.
+    //
+    for (size_t k = 0; k < batch.size (); k++) {
+      const uint64_t bit = (uint64_t) 1 << k;
+      if (!(transitive & bit)) continue;
+      Clause * c = batch[k];
       removed++;
       stats.transitive++;
       LOG (c, "transitive redundant");
       mark_garbage (c);
-    } else if (failed) {
+    }
+
+    for (size_t k = 0; !unsat && k < batch.size (); k++) {
+      const uint64_t bit = (uint64_t) 1 << k;
+      if (!(failed & bit)) continue;
+      const int src = sources[k];
+      const signed char tmp = val (src);
+      if (tmp < 0) continue;
       units++;
       LOG ("found failed literal %d during transitive reduction", src);
       stats.failed++;
       stats.transredunits++;
-      assign_unit (-src);
-      if (!propagate ()) {
-        VERBOSE (1, "propagating new unit results in conflict");
+      if (tmp > 0) {
+        VERBOSE (1, "failed literal already assigned results in conflict");
         learn_empty_clause ();
+      } else {
+        assign_unit (-src);
+        if (!propagate ()) {
+          VERBOSE (1, "propagating new unit results in conflict");
+          learn_empty_clause ();
+        }
       }
     }
+
+    batch.clear ();
+    sources.clear ();
+    targets.clear ();
   }
 
   last.transred.propagations = stats.propagations.search;
   stats.propagations.transred += propagations;
+  erase_vector (bits);
   erase_vector (work);
+  erase_vector (touched);
 
   PHASE ("transred", stats.transreds,
     "removed %" PRId64 " transitive clauses, found %" PRId64 " units",
@@ -37,6 +37,20 @@ namespace CaDiCaL {
 // with more occurrences first.  Then we sort clauses lexicographically with
 // respect to that literal order.
 
+// The sorted schedule plays the role of the trie and is kept across rounds
+// (separately for the irredundant mode and each redundant tier).  Tried
+// clauses leave the schedule.  Irredundant clauses added and clauses
+// strengthened since the last round are collected when this happens and
+// are then sorted and merged into the remaining schedule, which keeps the
+// literal order of the round in which it was built from scratch.  Thus
+// consecutive candidates keep sharing prefixes without searching all
+// clauses for new candidates and recomputing the literal order every
+// round.  The schedule is only rebuilt (and the literal order recomputed)
+// if it was completely tried or if the number of added clauses exceeds the
+// number of remaining scheduled clauses.  Learned clauses are only picked
+// up when rebuilding the schedule, as otherwise every conflict would add a
+// candidate and force rebuilding the schedule in almost every round.
+
 /*------------------------------------------------------------------------*/
 
 // For vivification we have a separate dedicated propagation routine, which
@@ -174,12 +188,14 @@ bool Internal::vivify_propagate () {
 struct vivify_more_noccs {
 
   Internal * internal;
+  const vector<int64_t> & noccs;
 
-  vivify_more_noccs (Internal * i) : internal (i) { }
+  vivify_more_noccs (Internal * i, const Vivifier & v) :
+    internal (i), noccs (v.noccs) { }
 
   bool operator () (int a, int b) {
-    int64_t n = internal->noccs (a);
-    int64_t m = internal->noccs (b);
+    int64_t n = noccs[internal->vlit (a)];
+    int64_t m = noccs[internal->vlit (b)];
     if (n > m) return true;     // larger occurrences / score first
     if (n < m) return false;    // smaller occurrences / score last
     if (a == -b) return a > 0;  // positive literal first
@@ -232,8 +248,10 @@ struct vivify_more_noccs {
 struct vivify_clause_later {
 
   Internal * internal;
+  const Vivifier & vivifier;
 
-  vivify_clause_later (Internal * i) : internal (i) { }
+  vivify_clause_later (Internal * i, const Vivifier & v) :
+    internal (i), vivifier (v) { }
 
   bool operator () (Clause * a, Clause * b) const {
 
@@ -243,10 +261,15 @@ struct vivify_clause_later {
     if (!a->vivify && b->vivify) return true;
     if (a->vivify && !b->vivify) return false;
 
-    // Among redundant clauses (in redundant mode) prefer small glue.
+    // Among redundant clauses (in redundant mode) first prefer clauses
+    // recently used in conflict analysis (see 'bump_clause') and then small
+    // glue.  Irredundant clauses are never aged by 'reduce' and thus their
+    // 'used' flag is ignored.
     //
     if (a->redundant) {
       assert (b->redundant);
+      if (a->used < b->used) return true;
+      if (a->used > b->used) return false;
       if (a->glue > b->glue) return true;
       if (a->glue < b->glue) return false;
     }
@@ -263,7 +286,7 @@ struct vivify_clause_later {
     const auto eoa = a->end (), eob = b->end ();
     auto j = b->begin ();
     for (auto i = a->begin (); i != eoa && j != eob; i++, j++)
-      if (*i != *j) return vivify_more_noccs (internal) (*j, *i);
+      if (*i != *j) return vivify_more_noccs (internal, vivifier) (*j, *i);
 
     return j == eob;    // Prefer shorter clauses to be vivified first.
   }
@@ -294,9 +317,7 @@ struct vivify_flush_smaller {
   }
 };
 
-void Internal::flush_vivification_schedule (Vivifier & vivifier) {
-
-  auto & schedule = vivifier.schedule;
+void Internal::flush_vivification_schedule (vector<Clause *> & schedule) {
 
   stable_sort (schedule.begin (), schedule.end (), vivify_flush_smaller ());
 
@@ -318,6 +339,7 @@ void Internal::flush_vivification_schedule (Vivifier & vivifier) {
       assert (!c->garbage);
       assert (!prev->garbage);
       assert (c->redundant || !prev->redundant);
+      c->scheduled = false;
       mark_garbage (c);
       subsumed++;
       j--;
@@ -340,18 +362,38 @@ void Internal::flush_vivification_schedule (Vivifier & vivifier) {
 
 // Depending on whether we try to vivify redundant or irredundant clauses,
 // we schedule a clause to be vivified.  For redundant clauses we only try
-// to vivify them if they are likely to survive the next 'reduce' operation.
+// to vivify them if they are likely to survive the next 'reduce' operation
+// and further only consider those in the given tier.
 
-bool Internal::consider_to_vivify_clause (Clause * c,
-                                          bool redundant_mode) {
+bool Internal::consider_to_vivify_clause (Clause * c, int tier) {
   if (c->garbage) return false;
-  if (c->redundant != redundant_mode) return false;
+  if (c->redundant != (tier > 0)) return false;
+  if (c->redundant &&
+      (c->keep || c->glue <= opts.reducetier2glue) != (tier == 2))
+    return false;
   if (opts.vivifyonce >= 1 && c->redundant && c->vivified) return false;
   if (opts.vivifyonce >= 2 && !c->redundant && c->vivified) return false;
   if (c->redundant && !likely_to_be_kept_clause (c)) return false;
   return true;
 }
 
+// Irredundant clauses which are added as well as clauses which are
+// strengthened or promoted to another tier are remembered as new
+// candidates of the schedule of their tier, which saves searching through
+// all clauses in every round.  Learned clauses and clauses which only later
+// become candidates (for instance since they are now likely to be kept)
+// are found as soon the schedule is rebuilt.
+
+void Internal::add_vivification_candidate (Clause * c) {
+  if (!opts.vivify) return;
+  if (c->scheduled) return;
+  if (c->size == 2) return;             // see also (NO-BINARY) below
+  int tier = 0;
+  if (c->redundant)
+    tier = (c->keep || c->glue <= opts.reducetier2glue) ? 2 : 3;
+  vivifiers[tier ? tier - 1 : 0].added.push_back (c);
+}
+
 // Conflict analysis from 'start' which learns a decision only clause.
 
 void Internal::vivify_analyze_redundant (Vivifier & vivifier,
@@ -550,6 +592,10 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
   c->vivify = false;                          // mark as checked / tried
   c->vivified = true;                         // and globally remember
 
+  if (c->used) stats.vivifyused++;
+  if (vivifier.tier == 2) stats.vivifytier2++;
+  if (vivifier.tier == 3) stats.vivifytier3++;
+
   if (c->garbage) return;
 
   // First check whether the candidate clause is already satisfied and at
@@ -574,7 +620,7 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
     return;
   }
 
-  sort (sorted.begin (), sorted.end (), vivify_more_noccs (this));
+  sort (sorted.begin (), sorted.end (), vivify_more_noccs (this, vivifier));
 
   // The actual vivification checking is performed here, by assuming the
   // negation of each of the remaining literals of the clause in turn and
@@ -751,7 +797,8 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
 
       stats.vivifydecs++;
       vivify_assume (-lit);
-      LOG ("negated decision %d score %" PRId64 "", lit, noccs (lit));
+      LOG ("negated decision %d score %" PRId64 "",
+        lit, vivifier.noccs[vlit (lit)]);
 
       if (vivify_propagate ()) continue;        // hot-spot
 
@@ -864,88 +911,216 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
 
 /*------------------------------------------------------------------------*/
 
-// There are two modes of vivification, one using all clauses and one
-// focusing on irredundant clauses only.  The latter variant working on
-// irredundant clauses only can also remove irredundant asymmetric
-// tautologies (clauses subsumed through unit propagation), which in
-// redundant mode is incorrect (due to propagating over redundant clauses).
+// Remove clauses from the persistent schedule which are not candidates of
+// its tier anymore, because they became garbage, were shrunken to binary
+// clauses or changed their tier (after promotion or if they are not likely
+// to be kept anymore).  Those which are still candidates of another tier
+// are passed on to that tier.
 
-void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
+void Internal::prune_vivification_schedule (Vivifier & vivifier) {
+  auto & schedule = vivifier.schedule;
+  const auto end = schedule.end ();
+  auto j = schedule.begin (), i = j;
+  for (; i != end; i++) {
+    Clause * c = *j++ = *i;
+    if (c->size > 2 && consider_to_vivify_clause (c, vivifier.tier))
+      continue;
+    c->scheduled = false;
+    j--;
+    if (c->garbage) continue;
+    if (c->size > 2) stats.vivifyretier++;      // changed tier
+    add_vivification_candidate (c);
+  }
+  schedule.resize (j - schedule.begin ());
+}
 
-  if (unsat) return;
-  if (terminated_asynchronously ()) return;
+// Merge clauses added or strengthened since the last round into the pruned
+// schedule.  If the schedule was completely tried or more clauses have
+// been added since it was last built than it has, then it is rebuilt from
+// scratch with a fresh literal order from all candidate clauses.
 
-  PHASE ("vivify", stats.vivifications,
-    "starting %s vivification round propagation limit %" PRId64 "",
-    redundant_mode ? "redundant" : "irredundant", propagation_limit);
+void Internal::update_vivification_schedule (Vivifier & vivifier) {
 
-  // Disconnect all watches since we sort literals within clauses.
-  //
-  if (watching ()) clear_watches ();
+  const int tier = vivifier.tier;
+  auto & schedule = vivifier.schedule;
 
-  // Count the number of occurrences of literals in all clauses,
-  // particularly binary clauses, which are usually responsible
-  // for most of the propagations.
-  //
-  init_noccs ();
+  prune_vivification_schedule (vivifier);
 
-  for (const auto & c : clauses) {
+  vector<Clause *> added;
+  for (const auto & c : vivifier.added) {
+    if (c->scheduled) continue;       // added twice or already merged
+    if (c->size == 2) continue;       // shrunken since added (NO-BINARY)
+    if (!consider_to_vivify_clause (c, tier)) continue;
+    c->scheduled = true;
+    added.push_back (c);
+  }
+  erase_vector (vivifier.added);
 
-    if (!consider_to_vivify_clause (c, redundant_mode)) continue;
+  const bool rebuild =
+    schedule.empty () ||
+    vivifier.noccs.size () < 2*vsize ||
+    vivifier.merged + added.size () > schedule.size ();
 
-    // This computes an approximation of the Jeroslow Wang heuristic score
-    //
-    //       nocc (L) =     sum       2^(12-|C|)
-    //                   L in C in F
-    //
-    // but we cap the size at 12, that is all clauses of size 12 and larger
-    // contribute '1' to the score, which allows us to use 'long' numbers.
-    // See the example above (search for '@1').
+  vivifier.merged += added.size ();
+
+  if (rebuild) {
+
+    for (const auto & c : added)
+      c->scheduled = false;
+    for (const auto & c : schedule)
+      c->scheduled = false;
+    added.clear ();
+    erase_vector (schedule);
+    vivifier.merged = 0;
+
+    // Count the number of occurrences of literals in all clauses,
+    // particularly binary clauses, which are usually responsible
+    // for most of the propagations.
     //
-    const int shift = 12 - c->size;
-    const int64_t score = shift < 1 ? 1 : (1l << shift);           // @4
+    auto & noccs = vivifier.noccs;
+    noccs.assign (2*vsize, 0);
 
-    for (const auto lit : *c)
-      noccs (lit) += score;
-  }
+    for (const auto & c : clauses) {
 
-  // Refill the schedule every time.  Unchecked clauses are 'saved' by
-  // setting their 'vivify' bit, such that they can be tried next time.
-  //
-  Vivifier vivifier (redundant_mode);
+      if (!consider_to_vivify_clause (c, tier)) continue;
 
-  // In the first round of filling the schedule check whether there are
-  // still clauses left, which were scheduled but have not been vivified yet.
-  // The second round is only entered if no such clause was found in the
-  // first round.  Then the second round selects all clauses.
-  //
-  for (const auto & c : clauses) {
+      // Clauses still scheduled are in the schedule of another tier.
+      //
+      if (c->size > 2 && !c->scheduled) added.push_back (c);
+
+      // This computes an approximation of the Jeroslow Wang heuristic
+      // score
+      //
+      //       nocc (L) =     sum       2^(12-|C|)
+      //                   L in C in F
+      //
+      // but we cap the size at 12, that is all clauses of size 12 and
+      // larger contribute '1' to the score, which allows us to use 'long'
+      // numbers.  See the example above (search for '@1').
+      //
+      const int shift = 12 - c->size;
+      const int64_t score = shift < 1 ? 1 : (1l << shift);         // @4
+
+      for (const auto lit : *c)
+        noccs[vlit (lit)] += score;
+    }
+
+    PHASE ("vivify", stats.vivifications,
+      "rebuilding tier %d schedule from %zd clauses", tier, added.size ());
 
-    if (c->size == 2) continue;       // see also (NO-BINARY) above
+    stats.vivifyrebuilt++;
 
-    if (!consider_to_vivify_clause (c, redundant_mode)) continue;
+  } else {
 
-    // Literals in scheduled clauses are sorted with their highest score
-    // literals first (as explained above in the example at '@2').  This
-    // is also needed in the prefix subsumption checking below.
+    // During search literals in kept clauses are reordered when watches
+    // are replaced and the keys 'vivify', 'used' and 'glue' of the order
+    // change too (for instance 'used' in 'bump_clause' and 'reduce').  Thus
+    // their literals are sorted again and the order of the schedule is
+    // restored (stable sorting an almost sorted schedule), since merging
+    // requires both the schedule and the added clauses to be sorted.
     //
-    sort (c->begin (), c->end (), vivify_more_noccs (this));
+    for (const auto & c : schedule)
+      sort (c->begin (), c->end (), vivify_more_noccs (this, vivifier));
+    stable_sort (schedule.begin (), schedule.end (),
+      vivify_clause_later (this, vivifier));
+
+    PHASE ("vivify", stats.vivifications,
+      "merging %zd clauses into tier %d schedule of %zd clauses",
+      added.size (), tier, schedule.size ());
 
-    vivifier.schedule.push_back (c);
+    stats.vivifymerged++;
   }
-  shrink_vector (vivifier.schedule);
+
+  // Literals in scheduled clauses are sorted with their highest score
+  // literals first (as explained above in the example at '@2').  This
+  // is also needed in the prefix subsumption checking below.
+  //
+  for (const auto & c : added)
+    sort (c->begin (), c->end (), vivify_more_noccs (this, vivifier));
 
   // Flush clauses subsumed by another clause with the same prefix, which
   // also includes flushing syntactically identical clauses.
   //
-  flush_vivification_schedule (vivifier);
+  flush_vivification_schedule (added);
 
   // Sort candidates, with first to be tried candidate clause last, i.e.,
   // many occurrences and high score literals) as in the example explained
   // above (search for '@3').
   //
-  stable_sort (vivifier.schedule.begin (), vivifier.schedule.end (),
-    vivify_clause_later (this));
+  stable_sort (added.begin (), added.end (),
+    vivify_clause_later (this, vivifier));
+
+  for (const auto & c : added)
+    c->scheduled = true;
+
+  if (schedule.empty ()) schedule.swap (added);
+  else {
+    vector<Clause *> merged;
+    merged.reserve (schedule.size () + added.size ());
+    merge (schedule.begin (), schedule.end (),
+           added.begin (), added.end (),
+           back_inserter (merged), vivify_clause_later (this, vivifier));
+    schedule.swap (merged);
+  }
+}
+
+// Scheduled and added clauses survive garbage collection.
+
+static void flush_collected_clauses (vector<Clause *> & clauses) {
+  const auto end = clauses.end ();
+  auto j = clauses.begin (), i = j;
+  for (; i != end; i++) {
+    Clause * c = *i;
+    if (c->collect ()) continue;
+    *j++ = c->moved ? c->copy : c;
+  }
+  clauses.resize (j - clauses.begin ());
+}
+
+void Internal::flush_vivification_schedules () {
+  for (auto & vivifier : vivifiers) {
+    flush_collected_clauses (vivifier.schedule);
+    flush_collected_clauses (vivifier.added);
+  }
+}
+
+// The literal order is invalid after renumbering variables in 'compact'.
+
+void Internal::reset_vivification_schedules () {
+  for (auto & vivifier : vivifiers) {
+    for (const auto & c : vivifier.schedule)
+      c->scheduled = false;
+    vivifier.erase ();
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// There are two modes of vivification, one using all clauses and one
+// focusing on irredundant clauses only.  The latter variant working on
+// irredundant clauses only can also remove irredundant asymmetric
+// tautologies (clauses subsumed through unit propagation), which in
+// redundant mode is incorrect (due to propagating over redundant clauses).
+// Redundant clauses are vivified in two rounds, one for each 'tier'.
+
+void Internal::vivify_round (int tier, int64_t propagation_limit) {
+
+  if (unsat) return;
+  if (terminated_asynchronously ()) return;
+
+  const bool redundant_mode = tier > 0;
+
+  PHASE ("vivify", stats.vivifications,
+    "starting tier %d vivification round propagation limit %" PRId64 "",
+    tier, propagation_limit);
+
+  // Disconnect all watches since we sort literals within clauses.
+  //
+  if (watching ()) clear_watches ();
+
+  Vivifier & vivifier = vivifiers[tier ? tier - 1 : 0];
+  assert (vivifier.tier == tier);
+  update_vivification_schedule (vivifier);
 
   // Remember old values of counters to summarize after each round with
   // verbose messages what happened in that round.
@@ -979,6 +1154,7 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
          stats.propagations.vivify < limit) {
     Clause * c = vivifier.schedule.back ();              // Next candidate.
     vivifier.schedule.pop_back ();
+    c->scheduled = false;
     vivify_clause (vivifier, c);
   }
 
@@ -986,8 +1162,6 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
 
   if (!unsat) {
 
-    reset_noccs ();
-
     int64_t still_need_to_be_vivified = 0;
     for (const auto & c : vivifier.schedule)
       if (c->vivify)
@@ -1008,7 +1182,8 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
         c->vivify = true;
     }
 
-    vivifier.erase ();          // Reclaim  memory early.
+    erase_vector (vivifier.sorted);     // Reclaim memory early but keep
+    erase_vector (vivifier.stack);      // the schedule for the next round.
   }
 
   clear_watches ();
@@ -1083,11 +1258,21 @@ void Internal::vivify () {
   PHASE ("vivify", stats.vivifications,
     "vivification limit of twice %" PRId64 " propagations", limit);
 
-  vivify_round (false, limit); // Vivify only irredundant clauses.
+  // Clauses might have changed their tier since the last vivification,
+  // thus first remove them from the schedules of their old tiers.
+  //
+  for (auto & vivifier : vivifiers)
+    prune_vivification_schedule (vivifier);
 
+  vivify_round (0, limit);     // Vivify only irredundant clauses.
+
+  // The effort for redundant clauses is split among the two tiers.
+  //
   limit *= 1e-3 * opts.vivifyredeff;
+  const int64_t tier2 = limit * 1e-2 * opts.vivifytier2;
 
-  vivify_round (true, limit);  // Vivify all clauses.
+  vivify_round (2, tier2);      // Vivify tier one and two clauses.
+  vivify_round (3, limit - tier2);      // Vivify kept tier three clauses.
 
   STOP_SIMPLIFIER (vivify, VIVIFY);
 
@@ -5,16 +5,31 @@ namespace CaDiCaL {
 
 struct Clause;
 
+// There is one vivifier for irredundant clauses ('tier' zero) and one for
+// each of the two tiers of redundant clauses kept in 'reduce' (tier two
+// contains tier one).  The schedule of a vivifier is kept across
+// vivification rounds.  Its clauses are sorted with respect to the literal
+// order given by 'noccs' (indexed by 'vlit'), which is only recomputed if
+// the schedule is rebuilt from scratch ('update_vivification_schedule').
+// Clauses added or strengthened since the last round are collected in
+// 'added' and merged into the schedule in the next round.
+
 struct Vivifier {
-  vector<Clause *> schedule, stack;
+  vector<Clause *> schedule, added, stack;
   vector<int> sorted;
+  vector<int64_t> noccs;
+  size_t merged;                // clauses merged since last rebuilt
+  int tier;                     // 0 (irredundant), 2 or 3 (redundant)
   bool redundant_mode;
-  Vivifier (bool mode) : redundant_mode (mode) { }
+  Vivifier (int t) : merged (0), tier (t), redundant_mode (t > 0) { }
 
   void erase () {
     erase_vector (schedule);
+    erase_vector (added);
     erase_vector (sorted);
     erase_vector (stack);
+    erase_vector (noccs);
+    merged = 0;
   }
 };
 
@@ -4,21 +4,18 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
-// Random walk local search based on 'ProbSAT' ideas.
+// Random walk local search based on 'ProbSAT' ideas with incrementally
+// updated break values (see 'walkcore.hpp').
 
-struct Walker {
+struct Walker : WalkCore {
 
   Internal * internal;
 
   Random random;                // local random number generator
   int64_t propagations;         // number of propagations
   int64_t limit;                // limit on number of propagations
-  vector <Clause *> broken;     // currently unsatisfied clauses
-  double epsilon;               // smallest considered score
-  vector<double> table;         // break value to score table
-  vector<double> scores;        // scores of candidate literals
-
-  double score (unsigned);      // compute score from break count
+  double ratio;                 // clauses traversed per propagation
+  vector<Clause *> clauses;     // clauses considered in local search
 
   Walker (Internal *, double size, int64_t limit);
 };
@@ -48,7 +45,7 @@ static const int ncbvals = sizeof cbvals / sizeof cbvals[0];
 //
 // where 'x' is the average size of clauses and 'y' the CB value.
 
-inline static double fitcbval (double size) {
+double fitcbval (double size) {
   int i = 0;
   while (i+2 < ncbvals && (cbvals[i][0] > size || cbvals[i+1][0] < size))
     i++;
@@ -67,7 +64,8 @@ Walker::Walker (Internal * i, double size, int64_t l) :
   internal (i),
   random (internal->opts.seed),         // global random seed
   propagations (0),
-  limit (l)
+  limit (l),
+  ratio (max (1.0, internal->clause_variable_ratio ()))
 {
   random += internal->stats.walk.count; // different seed every time
 
@@ -77,24 +75,78 @@ Walker::Walker (Internal * i, double size, int64_t l) :
   //
   const bool use_size_based_cb = (internal->stats.walk.count & 1);
   const double cb = use_size_based_cb ? fitcbval (size) : 2.0;
-  assert (cb);
-  const double base = 1/cb;     // scores are 'base^0,base^1,base^2,...
+  init (internal->max_var, cb);
+
+  PHASE ("walk", internal->stats.walk.count,
+    "CB %.2f with inverse %.2f as base and table size %zd",
+    cb, 1/cb, table.size ());
+}
 
+// Allocate break values and tabulate the scores 'base^0,base^1,...' with
+// 'base = 1/cb' until they underflow.
+
+void WalkCore::init (int max_var, double cb) {
+  assert (cb > 0);
+  const double base = 1/cb;
   double next = 1;
   for (epsilon = next; next; next = epsilon*base)
     table.push_back (epsilon = next);
+  starts.resize (2u * max_var + 3, 0);
+  breaks.resize (max_var + 1, 0);
+}
 
-  PHASE ("walk", internal->stats.walk.count,
-    "CB %.2f with inverse %.2f as base and table size %zd",
-    cb, base, table.size ());
+void WalkCore::sum (size_t clauses) {
+  for (size_t i = 1; i < starts.size (); i++)
+    starts[i] += starts[i - 1];
+  occs.resize (starts.back ());
+  counts.resize (clauses, 0);
+  criticals.resize (clauses, 0);
+  positions.resize (clauses, 0);
+  next.assign (starts.begin (), starts.end () - 1);
 }
 
-// The scores are tabulated for faster computation (to avoid 'pow').
+void WalkCore::connect (unsigned id, unsigned count, unsigned critical) {
+  counts[id] = count;
+  criticals[id] = critical;
+  if (count == 1) breaks[critical]++;
+  else if (!count) brake (id);
+}
 
-inline double Walker::score (unsigned i) {
-  const double res = (i < table.size () ? table[i] : epsilon);
-  LOG ("break %u mapped to score %g", i, res);
-  return res;
+// First increase the number of true literals of the clauses containing
+// 'lit', which makes broken clauses and removes the only critical variable
+// of clauses which had exactly one true literal before.  Then decrease the
+// number of true literals of the clauses containing '-lit', which breaks
+// clauses and adds a critical variable to clauses which are left with
+// exactly one true literal.
+
+void WalkCore::flip (int lit) {
+  const unsigned idx = lit < 0 ? -lit : lit;
+  const unsigned pos = code (lit), neg = pos ^ 1;
+  for (unsigned i = starts[pos]; i != starts[pos + 1]; i++) {
+    const unsigned id = occs[i];
+    unsigned & count = counts[id], & critical = criticals[id];
+    if (!count) {
+      make (id);
+      breaks[idx]++;
+    } else if (count == 1) {
+      assert (breaks[critical] > 0);
+      breaks[critical]--;
+    }
+    critical ^= idx;
+    count++;
+  }
+  for (unsigned i = starts[neg]; i != starts[neg + 1]; i++) {
+    const unsigned id = occs[i];
+    unsigned & count = counts[id], & critical = criticals[id];
+    assert (count > 0);
+    critical ^= idx;
+    if (!--count) {
+      assert (!critical);
+      brake (id);
+      assert (breaks[idx] > 0);
+      breaks[idx]--;
+    } else if (count == 1) breaks[critical]++;
+  }
 }
 
 /*------------------------------------------------------------------------*/
@@ -105,69 +157,20 @@ Clause * Internal::walk_pick_clause (Walker & walker) {
   int64_t size = walker.broken.size ();
   if (size > INT_MAX) size = INT_MAX;
   int pos = walker.random.pick_int (0, size-1);
-  Clause * res = walker.broken[pos];
+  Clause * res = walker.clauses[walker.broken[pos]];
   LOG (res, "picking random position %d", pos);
   return res;
 }
 
 /*------------------------------------------------------------------------*/
 
-// Compute the number of clauses which would be become unsatisfied if 'lit'
-// is flipped and set to false.  This is called the 'break-count' of 'lit'.
-
-unsigned Internal::walk_break_value (int lit) {
+// The number of clauses which would become unsatisfied if 'lit' is flipped
+// and set to false.  This is called the 'break-count' of 'lit'.
 
+inline unsigned Internal::walk_break_value (Walker & walker, int lit) {
   require_mode (WALK);
   assert (val (lit) > 0);
-
-  unsigned res = 0;             // The computed break-count of 'lit'.
-
-  for (auto & w : watches (lit)) {
-    assert (w.blit != lit);
-    if (val (w.blit) > 0) continue;
-    if (w.binary ()) { res++; continue; }
-
-    Clause * c = w.clause;
-    assert (lit == c->literals[0]);
-
-    // Now try to find a second satisfied literal starting at 'literals[1]'
-    // shifting all the traversed literals to right by one position in order
-    // to move such a second satisfying literal to 'literals[1]'.  This move
-    // to front strategy improves the chances to find the second satisfying
-    // literal earlier in subsequent break-count computations.
-    //
-    auto begin = c->begin () + 1;
-    const auto end = c->end ();
-    auto i = begin;
-    int prev = 0;
-    while (i != end) {
-      const int other = *i;
-      *i++ = prev;
-      prev = other;
-      if (val (other) < 0) continue;
-
-      // Found 'other' as second satisfying literal.
-
-      w.blit = other;                   // Update 'blit'
-      *begin = other;                   // and move to front.
-
-      break;
-    }
-
-    if (i != end) continue;     // Double satisfied!
-
-    // Otherwise restore literals (undo shift to the right).
-    //
-    while (i != begin) {
-      const int other = *--i;
-      *i = prev;
-      prev = other;
-    }
-
-    res++;      // Literal 'lit' single satisfies clause 'c'.
-  }
-
-  return res;
+  return walker.breaks[abs (lit)];
 }
 
 /*------------------------------------------------------------------------*/
@@ -187,7 +190,6 @@ int Internal::walk_pick_lit (Walker & walker, Clause * c) {
   LOG ("picking literal by break-count");
   assert (walker.scores.empty ());
   double sum = 0;
-  int64_t propagations = 0;
   for (const auto lit : *c) {
     assert (active (lit));
     if (var (lit).level == 1) {
@@ -195,8 +197,7 @@ int Internal::walk_pick_lit (Walker & walker, Clause * c) {
       continue;
     }
     assert (active (lit));
-    propagations++;
-    unsigned tmp = walk_break_value (-lit);
+    unsigned tmp = walk_break_value (walker, -lit);
     double score = walker.score (tmp);
     LOG ("literal %d break-count %u score %g", lit, tmp, score);
     walker.scores.push_back (score);
@@ -204,8 +205,6 @@ int Internal::walk_pick_lit (Walker & walker, Clause * c) {
   }
   LOG ("scored %zd literals", walker.scores.size ());
   assert (!walker.scores.empty ());
-  walker.propagations += propagations;
-  stats.propagations.walk += propagations;
   assert (walker.scores.size () <= (size_t) c->size);
   const double lim = sum * walker.random.generate_double ();
   LOG ("score sum %g limit %g", sum, lim);
@@ -249,127 +248,26 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
   vals[-idx] = -tmp;
   assert (val (lit) > 0);
 
-  // Then remove 'c' and all other now satisfied (made) clauses.
-  {
-    // Simply go over all unsatisfied (broken) clauses.
-
-    LOG ("trying to make %zd broken clauses", walker.broken.size ());
-
-    // We need to measure (and bound) the memory accesses during traversing
-    // broken clauses in terms of 'propagations'. This is tricky since we
-    // are not actually propagating literals.  Instead we use the clause
-    // variable 'ratio' as an approximation to the number of clauses used
-    // during propagating a literal.  Note that we use a one-watch scheme.
-    // Accordingly the number of broken clauses traversed divided by that
-    // ratio is an approximation of the number of propagation this would
-    // correspond to (in terms of memory access).  To eagerly update these
-    // statistics we simply increment the propagation counter after every
-    // 'ratio' traversed clause.  These propagations are particularly
-    // expensive if the number of broken clauses is large which usually
-    // happens initially.
-    //
-    const double ratio = clause_variable_ratio ();
-    const auto eou = walker.broken.end ();
-    auto j = walker.broken.begin (), i = j;
-    int64_t made = 0, count = 0;
-
-    while (i != eou) {
-
-      Clause * d = *j++ = *i++;
-
-      int * literals = d->literals, prev = 0;
-
-      // Find 'lit' in 'd'.
-      //
-      const int size = d->size;
-      for (int i = 0; i < size; i++) {
-        const int other = literals[i];
-        assert (active (other));
-        literals[i] = prev;
-        prev = other;
-        if (other == lit) break;
-        assert (val (other) < 0);
-      }
-
-      // If 'lit' is in 'd' then move it to the front to watch it.
-      //
-      if (prev == lit) {
-        literals[0] = lit;
-        LOG (d, "made");
-        watch_literal (literals[0], literals[1], d);
-        made++;
-        j--;
-
-      } else {  // Otherwise the clause is not satisfied, undo shift.
-
-        for (int i = size-1; i >= 0; i--) {
-          int other = literals[i];
-          literals[i] = prev;
-          prev = other;
-        }
-      }
-
-      if (count--) continue;
-
-      // Update these counters eagerly.  Otherwise if we delay the update
-      // until all clauses are traversed, interrupting the solver has a high
-      // chance of giving bogus statistics on the number of 'propagations'
-      // in 'walk', if it is interrupted in this loop.
-
-      count = ratio;                    // Starting counting down again.
-      walker.propagations++;
-      stats.propagations.walk++;
-    }
-    LOG ("made %" PRId64 " clauses by flipping %d", made, lit);
-    walker.broken.resize (j - walker.broken.begin ());
-  }
-
-  // Finally add all new unsatisfied (broken) clauses.
-  {
-    walker.propagations++;      // This really corresponds now to one
-    stats.propagations.walk++;  // propagation (in a one-watch scheme).
-
-    int64_t broken = 0;
-    Watches & ws = watches (-lit);
-
-    LOG ("trying to brake %zd watched clauses", ws.size ());
-
-    for (const auto & w : ws) {
-      Clause * d = w.clause;
-      LOG (d, "unwatch %d in", -lit);
-      int * literals = d->literals, replacement = 0, prev = -lit;
-      assert (literals[0] == -lit);
-      const int size = d->size;
-      for (int i = 1; i < size; i++) {
-        const int other = literals[i];
-        assert (active (other));
-        literals[i] = prev;             // shift all to right
-        prev = other;
-        const signed char tmp = val (other);
-        if (tmp < 0) continue;
-        replacement = other;            // satisfying literal
-        break;
-      }
-      if (replacement) {
-        literals[1] = -lit;
-        literals[0] = replacement;
-        assert (-lit != replacement);
-        watch_literal (replacement, -lit, d);
-      } else {
-        for (int i = size-1; i > 0; i--) {      // undo shift
-          const int other = literals[i];
-          literals[i] = prev;
-          prev = other;
-        }
-        assert (literals[0] == -lit);
-        LOG (d, "broken");
-        walker.broken.push_back (d);
-        broken++;
-      }
-    }
-    LOG ("broken %" PRId64 " clauses by flipping %d", broken, lit);
-    ws.clear ();
-  }
+  // Then update the counts of the clauses containing 'lit' and '-lit'.
+  //
+#ifdef LOGGING
+  const size_t broken = walker.broken.size ();
+#endif
+  walker.flip (lit);
+  LOG ("flipping %d changed broken clauses from %zd to %zd",
+    lit, broken, walker.broken.size ());
+
+  // We need to measure (and bound) the memory accesses during flipping in
+  // terms of 'propagations'.  As an approximation to the number of clauses
+  // used during propagating a literal we use the clause variable 'ratio'.
+  // Thus the number of traversed occurrences divided by that ratio is an
+  // approximation of the number of propagations this would correspond to.
+  //
+  const size_t traversed =
+    walker.occurrences (lit) + walker.occurrences (-lit);
+  const int64_t propagations = 1 + traversed / walker.ratio;
+  walker.propagations += propagations;
+  stats.propagations.walk += propagations;
 }
 
 /*------------------------------------------------------------------------*/
@@ -497,64 +395,71 @@ int Internal::walk_round (int64_t limit, bool prev) {
       LOG ("initial assign %d to decision phase", tmp < 0 ? -idx : idx);
     }
 
-    LOG ("watching satisfied and registering broken clauses");
-#ifdef LOGGING
-    int64_t watched = 0;
-#endif
-    for (const auto c : clauses) {
+    LOG ("counting true literals and registering broken clauses");
 
+    // Gather the clauses and count their literal occurrences first, then
+    // fill the flattened occurrence lists.
+    //
+    for (const auto c : clauses) {
       if (c->garbage) continue;
       if (c->redundant) {
         if (!opts.walkredundant) continue;
         if (!likely_to_be_kept_clause (c)) continue;
       }
+      walker.clauses.push_back (c);
+      for (const auto & lit : *c)
+        walker.count (lit);
+    }
 
-      bool satisfiable = false;         // contains not only assumptions
-      int satisfied = 0;                // clause satisfied?
+    const size_t size = walker.clauses.size ();
+    walker.sum (size);
+
+    for (unsigned id = 0; id < size; id++)
+      for (const auto & lit : *walker.clauses[id])
+        walker.add (id, lit);
+
+#ifdef LOGGING
+    int64_t satisfied_clauses = 0;
+#endif
+    for (unsigned id = 0; !failed && id < size; id++) {
 
-      int * lits = c->literals;
-      const int size = c->size;
+      Clause * c = walker.clauses[id];
 
-      // Move to front satisfied literals and determine whether there
-      // is at least one (non-assumed) literal that can be flipped.
+      bool satisfiable = false;         // contains not only assumptions
+      unsigned count = 0, critical = 0;
+
+      // Count satisfied literals and determine whether there is at least
+      // one (non-assumed) literal that can be flipped.
       //
-      for (int i = 0; satisfied < 2 && i < size; i++) {
-        const int lit = lits[i];
+      for (const auto & lit : *c) {
         assert (active (lit));  // Due to garbage collection.
         if (val (lit) > 0) {
-          swap (lits[satisfied], lits[i]);
-          if (!satisfied++) LOG ("first satisfying literal %d", lit);
-        } else if (!satisfiable && var (lit).level > 1) {
-          LOG ("non-assumption potentially satisfying literal %d", lit);
-          satisfiable = true;
-        }
+          count++;
+          critical ^= abs (lit);
+        } else if (var (lit).level > 1) satisfiable = true;
       }
 
-      if (!satisfied && !satisfiable) {
+      if (!count && !satisfiable) {
         LOG (c, "due to assumptions unsatisfiable");
         LOG ("stopping local search since assumptions falsify a clause");
         failed = true;
         break;
       }
 
-      if (satisfied) {
-        watch_literal (lits[0], lits[1], c);
+      walker.connect (id, count, critical);
+
 #ifdef LOGGING
-        watched++;
+      if (count) satisfied_clauses++;
+      else LOG (c, "broken");
 #endif
-      } else {
-        assert (satisfiable);   // at least one non-assumed variable ...
-        LOG (c, "broken");
-        walker.broken.push_back (c);
-      }
     }
 #ifdef LOGGING
     if (!failed) {
       int64_t broken = walker.broken.size ();
-      int64_t total = watched + broken;
-      LOG ("watching %" PRId64 " clauses %.0f%% "
-           "out of %" PRId64 " (watched and broken)",
-        watched, percent (watched, total), total);
+      int64_t total = satisfied_clauses + broken;
+      LOG ("satisfied %" PRId64 " clauses %.0f%% "
+           "out of %" PRId64 " (satisfied and broken)",
+        satisfied_clauses, percent (satisfied_clauses, total), total);
     }
 #endif
   }
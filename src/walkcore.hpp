@@ -0,0 +1,87 @@
+#ifndef _walkcore_hpp_INCLUDED
+#define _walkcore_hpp_INCLUDED
+
+#include <cassert>
+#include <vector>
+
+namespace CaDiCaL {
+
+using namespace std;
+
+// The 'ProbSAT' core shared by local search in 'walk' and the background
+// worker in 'walkthread'.  As in 'ProbSAT' and 'YalSAT' we maintain for
+// each clause (given by its index) the number of its true literals and the
+// XOR of the variables of its true literals.  If a clause has exactly one
+// true literal the latter is its 'critical' variable.  The break value of
+// each variable, i.e., the number of clauses in which it is critical, is
+// cached and updated incrementally while flipping.  Thus flipping a
+// variable only needs to traverse the occurrence lists of its two literals
+// and picking a literal to flip in a broken clause is linear in its size.
+//
+// The flattened occurrence lists are built in three passes over the
+// clauses: first 'count' all literals, then 'sum' the counts, and then
+// 'add' the literals again in the same order.  Afterwards the initial
+// number of true literals and critical variable of each clause are
+// registered with 'connect'.  The literal 'lit' is mapped to the index
+// '2*abs(lit)+(lit<0)' of its occurrence list (the same as 'vlit').
+
+struct WalkCore {
+
+  vector<unsigned> counts;      // number of true literals per clause
+  vector<unsigned> criticals;   // XOR of variables of true literals
+  vector<unsigned> breaks;      // cached break value per variable
+  vector<unsigned> starts;      // start of occurrences per literal
+  vector<unsigned> occs;        // flattened occurrence lists
+  vector<unsigned> next;        // end of occurrences while adding
+  vector<unsigned> broken;      // currently unsatisfied clauses
+  vector<unsigned> positions;   // of broken clauses in 'broken'
+  double epsilon;               // smallest considered score
+  vector<double> table;         // break value to score table
+  vector<double> scores;        // scores of candidate literals
+
+  WalkCore () : epsilon (0) { }
+
+  static unsigned code (int lit) {
+    return 2u * (unsigned) (lit < 0 ? -lit : lit) + (lit < 0);
+  }
+
+  void init (int max_var, double cb); // break values and score table
+  void count (int lit) { starts[code (lit) + 1]++; }
+  void sum (size_t clauses);          // prefix sums and allocate
+  void add (unsigned id, int lit) { occs[next[code (lit)]++] = id; }
+  void connect (unsigned id, unsigned count, unsigned critical);
+
+  size_t occurrences (int lit) const {
+    const unsigned c = code (lit);
+    return starts[c + 1] - starts[c];
+  }
+
+  // The scores are tabulated for faster computation (to avoid 'pow').
+
+  double score (unsigned i) const {
+    return i < table.size () ? table[i] : epsilon;
+  }
+
+  void make (unsigned id) {             // remove from 'broken'
+    const unsigned pos = positions[id];
+    assert (pos < broken.size ());
+    assert (broken[pos] == id);
+    const unsigned last = broken.back ();
+    broken[pos] = last;
+    positions[last] = pos;
+    broken.pop_back ();
+  }
+
+  void brake (unsigned id) {            // add to 'broken'
+    positions[id] = broken.size ();
+    broken.push_back (id);
+  }
+
+  void flip (int lit);  // update counts after 'lit' became true
+};
+
+double fitcbval (double size);  // 'CB' value of 'ProbSAT' in 'walk.cpp'
+
+}
+
+#endif
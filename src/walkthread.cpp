@@ -0,0 +1,221 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Local search in 'walk' runs synchronously during rephasing.  Thus CDCL
+// search stops while local search runs and vice versa.  With the option
+// 'walkthread' a background thread runs 'ProbSAT' style local search
+// continuously on a spare core instead.  It works on a snapshot of the
+// irredundant clauses (without root level assigned literals and satisfied
+// clauses), which is taken again at rephasing if the irredundant clauses
+// changed since (for instance after 'elim').  The worker publishes its
+// best assignment into a buffer of atomic phases, which is imported in
+// 'rephase_walk' instead of running 'walk'.  The thread is stopped when
+// leaving search and before variables are renumbered in 'compact'.
+
+/*------------------------------------------------------------------------*/
+
+#ifndef NTHREADS
+
+// The local search algorithm of the worker is the same as in 'walk' and
+// shares its break value bookkeeping ('WalkCore'), but does not access the
+// solver.
+
+void WalkThread::run () {
+
+  Random random (seed);
+  WalkCore core;
+
+  vector<unsigned> clauses;             // start of clauses in 'literals'
+  bool start = true;
+  for (size_t i = 0; i < literals.size (); i++) {
+    const int lit = literals[i];
+    if (!lit) { start = true; continue; }
+    if (start) clauses.push_back (i), start = false;
+  }
+
+  // Exponential scores based on the 'CB' value fitted to the average size.
+
+  const size_t size = clauses.size ();
+  const double average = size ? (literals.size () - size) / (double) size : 0;
+  core.init (max_var, fitcbval (average));
+
+  for (const auto & lit : literals)
+    if (lit) core.count (lit);
+  core.sum (size);
+  for (unsigned id = 0; id < size; id++)
+    for (const int * p = &literals[clauses[id]]; *p; p++)
+      core.add (id, *p);
+
+  for (unsigned id = 0; id < size; id++) {
+    unsigned count = 0, critical = 0;
+    for (const int * p = &literals[clauses[id]]; *p; p++) {
+      const int lit = *p, idx = abs (lit);
+      if ((lit < 0 ? -values[idx] : values[idx]) <= 0) continue;
+      count++;
+      critical ^= idx;
+    }
+    core.connect (id, count, critical);
+  }
+
+  const vector<unsigned> & broken = core.broken;
+  vector<double> & scores = core.scores;
+
+  auto publish = [&] () {
+    for (int idx = 1; idx <= max_var; idx++)
+      best[idx].store (values[idx], memory_order_relaxed);
+    minimum.store (broken.size (), memory_order_relaxed);
+    published.fetch_add (1, memory_order_release);
+  };
+
+  // Improved assignments are published at most every 'max_var' flips (and
+  // only if the current assignment is as good as the best seen) in order
+  // to keep copying assignments in 'publish' amortized constant per flip.
+
+  const size_t max_size = INT_MAX;
+  size_t local_minimum = broken.size ();
+  int64_t local_flips = 0, last_published = 0;
+  bool pending = true;
+
+  while (!terminate.load (memory_order_relaxed)) {
+
+    if (pending &&
+        broken.size () == local_minimum &&
+        (broken.empty () || local_flips - last_published >= max_var)) {
+      publish ();
+      last_published = local_flips;
+      pending = false;
+    }
+
+    if (broken.empty ()) break;
+
+    // Pick a random broken clause and a literal in it by break value.
+
+    const unsigned id =
+      broken[random.pick_int (0, (int) min (broken.size (), max_size) - 1)];
+    const int * lits = &literals[clauses[id]];
+    double sum = 0;
+    for (const int * p = lits; *p; p++) {
+      const double score = core.score (core.breaks[abs (*p)]);
+      scores.push_back (score);
+      sum += score;
+    }
+    const double lim = sum * random.generate_double ();
+    const int * p = lits;
+    sum = scores[0];
+    while (sum <= lim && p[1]) sum += scores[++p - lits];
+    scores.clear ();
+
+    // Flip 'lit' to true and update counts and break values.
+
+    const int lit = *p;
+    values[abs (lit)] = lit < 0 ? -1 : 1;
+    core.flip (lit);
+
+    if (!(++local_flips & 1023))
+      flips.store (local_flips, memory_order_relaxed);
+
+    if (broken.size () < local_minimum) {
+      local_minimum = broken.size ();
+      pending = true;
+    }
+  }
+
+  flips.store (local_flips, memory_order_relaxed);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Cheap signature of the irredundant clauses to determine whether the
+// snapshot of the worker is outdated.
+
+int64_t Internal::walk_thread_signature () {
+  return stats.added.irredundant + stats.current.irredundant +
+         stats.all.eliminated + stats.all.substituted;
+}
+
+void Internal::start_walk_thread () {
+#ifndef NTHREADS
+  assert (opts.walkthread);
+  assert (!walkthread);
+
+  walkthread = new WalkThread ();
+  WalkThread & w = *walkthread;
+  w.max_var = max_var;
+  w.seed = opts.seed + stats.walkthreads;
+  w.signature = walk_thread_signature ();
+
+  for (const auto & c : clauses) {
+    if (c->garbage || c->redundant) continue;
+    bool satisfied = false;
+    const size_t old_size = w.literals.size ();
+    for (const auto & lit : *c) {
+      const int tmp = fixed (lit);
+      if (tmp > 0) { satisfied = true; break; }
+      if (tmp < 0) continue;
+      w.literals.push_back (lit);
+    }
+    if (satisfied || w.literals.size () == old_size)
+      w.literals.resize (old_size);
+    else w.literals.push_back (0);
+  }
+
+  // Start from the saved phases (which include imported phases).
+
+  w.values.resize (max_var + 1, 0);
+  w.best.reset (new atomic<signed char>[max_var + 1]);
+  for (auto idx : vars) {
+    const int tmp = active (idx) ? sign (decide_phase (idx, true)) : 1;
+    w.values[idx] = tmp;
+    w.best[idx].store (tmp, memory_order_relaxed);
+  }
+
+  PHASE ("walkthread", stats.walkthreads,
+    "starting background local search on %zd literals",
+    w.literals.size ());
+
+  stats.walkthreads++;
+  w.worker = thread (&WalkThread::run, walkthread);
+#endif
+}
+
+void Internal::stop_walk_thread () {
+  if (!walkthread) return;
+#ifndef NTHREADS
+  walkthread->terminate = true;
+  walkthread->worker.join ();
+  stats.walkthreadflips += walkthread->flips;
+#endif
+  delete walkthread;
+  walkthread = 0;
+}
+
+// Copy the best assignment of the worker to the saved phases if it
+// published a new one since the last import.
+
+bool Internal::import_walk_thread_phases () {
+  if (!walkthread) return false;
+#ifndef NTHREADS
+  WalkThread & w = *walkthread;
+  const int64_t published = w.published.load (memory_order_acquire);
+  if (published == w.imported) return false;
+  w.imported = published;
+  const int end = min (max_var, w.max_var);
+  for (int idx = 1; idx <= end; idx++)
+    if (active (idx))
+      phases.saved[idx] = w.best[idx].load (memory_order_relaxed);
+  stats.walkthreadimports++;
+  PHASE ("walkthread", stats.walkthreads,
+    "imported phases with %" PRId64 " broken clauses after %" PRId64
+    " flips", (int64_t) w.minimum, (int64_t) w.flips);
+  return true;
+#else
+  return false;
+#endif
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef _walkthread_hpp_INCLUDED
+#define _walkthread_hpp_INCLUDED
+
+#ifndef NTHREADS
+#include <atomic>
+#include <memory>
+#include <thread>
+#endif
+
+#include <vector>
+
+namespace CaDiCaL {
+
+using namespace std;
+
+// Local search running concurrently to CDCL search in a background thread
+// (with 'opts.walkthread').  The worker only works on its own snapshot of
+// the irredundant clauses and publishes every improved assignment to the
+// 'best' phase buffer, which is read without locking by the solver at the
+// next rephase (see 'walkthread.cpp').  Without thread support ('NTHREADS'
+// defined) the worker is never started.
+
+struct WalkThread {
+
+  vector<int> literals;         // zero terminated snapshot of clauses
+  vector<signed char> values;   // initial and then current assignment
+  uint64_t seed;                // for local random number generator
+  int max_var;                  // at the time of the snapshot
+  int64_t signature;            // of the irredundant clauses in snapshot
+
+#ifndef NTHREADS
+  thread worker;
+  atomic<bool> terminate;               // set by solver to stop worker
+  atomic<int64_t> flips;                // flips done so far
+  atomic<int64_t> minimum;              // broken clauses of 'best'
+  atomic<int64_t> published;            // improved 'best' assignments
+  unique_ptr<atomic<signed char>[]> best;
+#endif
+  int64_t imported;             // published assignments already used
+
+  WalkThread () :
+    seed (0), max_var (0), signature (0),
+#ifndef NTHREADS
+    terminate (false), flips (0), minimum (INT64_MAX), published (0),
+#endif
+    imported (0) { }
+
+  void run ();                  // executed by the background thread
+};
+
+}
+
+#endif
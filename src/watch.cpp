@@ -34,6 +34,7 @@ void Internal::connect_watches (bool irredundant_only) {
   for (const auto & c : clauses) {
     if (irredundant_only && c->redundant) continue;
     if (c->garbage || c->size > 2) continue;
+    if (c->amo) continue;       // replaced by AMO constraint
     watch_clause (c);
   }
 
@@ -42,6 +43,7 @@ void Internal::connect_watches (bool irredundant_only) {
   for (const auto & c : clauses) {
     if (irredundant_only && c->redundant) continue;
     if (c->garbage || c->size == 2) continue;
+    if (c->parity) continue;    // replaced by XOR constraint
     watch_clause (c);
     if (!level) {
       const int lit0 = c->literals[0];
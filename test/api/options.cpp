@@ -0,0 +1,141 @@
+#include "../../src/cadical.hpp"
+
+#include <iostream>
+#include <vector>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+// Incrementally solve random formulas with XOR and at-most-one constraints
+// using options which enable procedures disabled by default, compare the
+// results with those of a solver with default options and check models.
+
+struct Option { const char * name; int val; };
+
+static const std::vector<std::vector<Option>> configurations = {
+  { { "subsumethreads", 4 }, { "subsumeint", 10 } },
+  { { "elimthreads", 4 }, { "elimint", 10 } },
+  { { "gauss", 1 }, { "probeint", 10 }, { "checkproof", 0 } },
+  { { "gauss", 1 }, { "probeint", 10 }, { "check", 0 } },
+  { { "amo", 1 }, { "amominsize", 3 } },
+  { { "amo", 1 }, { "amominsize", 3 }, { "check", 0 } },
+  { { "xors", 1 } },
+  { { "xors", 1 }, { "check", 0 } },
+  { { "walkthread", 1 }, { "rephaseint", 10 } },
+  { { "luckythreads", 4 } },
+  { { "block", 1 }, { "elimint", 10 }, { "elimocclim", 0 } },
+  { { "block", 1 }, { "blockinc", 0 },
+    { "elimint", 10 }, { "elimocclim", 0 } },
+  { { "cover", 1 }, { "elimint", 10 }, { "elimocclim", 0 } },
+  { { "cover", 1 }, { "covercache", 0 },
+    { "elimint", 10 }, { "elimocclim", 0 } },
+  { { "condition", 1 }, { "conditionint", 10 } },
+  { { "condition", 1 }, { "conditionint", 10 }, { "conditionpure", 0 } },
+  { { "decomposethreads", 4 }, { "probeint", 10 } },
+  { { "lrb", 3 } },
+  { { "lrb", 3 }, { "lrbbcp", 1 } },
+  { { "restartrl", 1 }, { "restartrlint", 10 } },
+  { { "restartrl", 1 }, { "restartrlint", 10 },
+    { "restartrlgeom", 1 }, { "restartrlluby", 1 } },
+  { { "resets", 1 } },
+  { { "resets", 1 }, { "resetarm", 2 } },
+  { { "resets", 1 }, { "resetarm", 3 } },
+  { { "resets", 1 }, { "resetarm", 4 } },
+  { { "reduceactivity", 1 }, { "reduceint", 10 } },
+};
+
+static unsigned state;
+
+static int pick (int n) {
+  state = state * 1664525u + 1013904223u;
+  return (state >> 8) % n;
+}
+
+static int literal (int vars) {
+  const int idx = 1 + pick (vars);
+  return pick (2) ? idx : -idx;
+}
+
+static void add (std::vector<std::vector<int>> & clauses,
+                 CaDiCaL::Solver & a, CaDiCaL::Solver & b,
+                 const std::vector<int> & clause) {
+  for (auto lit : clause) a.add (lit), b.add (lit);
+  a.add (0), b.add (0);
+  clauses.push_back (clause);
+}
+
+static void check (CaDiCaL::Solver & solver,
+                   const std::vector<std::vector<int>> & clauses,
+                   const std::vector<int> & assumptions) {
+  for (auto lit : assumptions) assert (solver.val (lit) > 0);
+  for (const auto & clause : clauses) {
+    bool satisfied = false;
+    for (auto lit : clause)
+      if (solver.val (lit) > 0) { satisfied = true; break; }
+    assert (satisfied);
+  }
+}
+
+static void run (const std::vector<Option> & options, unsigned seed) {
+  const int vars = 150, rounds = 8;
+  CaDiCaL::Solver reference, solver;
+  solver.set ("check", 1);
+  for (const auto & option : options) {
+    bool valid = solver.set (option.name, option.val);
+    assert (valid), (void) valid;
+  }
+  std::vector<std::vector<int>> clauses;
+  state = seed;
+  for (int round = 0; round < rounds; round++) {
+    for (int i = 0; i < 4; i++) {                       // XOR of size 3
+      const int x = literal (vars);
+      const int y = 1 + pick (vars), z = 1 + pick (vars);
+      add (clauses, reference, solver, { x, y, z });
+      add (clauses, reference, solver, { x, -y, -z });
+      add (clauses, reference, solver, { -x, y, -z });
+      add (clauses, reference, solver, { -x, -y, z });
+    }
+    std::vector<int> amo;                               // pairwise AMO
+    for (int i = 0; i < 6; i++) amo.push_back (literal (vars));
+    for (size_t i = 0; i < amo.size (); i++)
+      for (size_t j = i + 1; j < amo.size (); j++)
+        add (clauses, reference, solver, { -amo[i], -amo[j] });
+    for (int i = 0; i < 60; i++)
+      add (clauses, reference, solver,
+           { literal (vars), literal (vars), literal (vars) });
+    const int gate = vars + 1 + round;                  // unused AND gate
+    const int a = literal (vars), b = literal (vars);
+    add (clauses, reference, solver, { -gate, a });
+    add (clauses, reference, solver, { -gate, b });
+    add (clauses, reference, solver, { gate, -a, -b });
+    for (int assumed = 0; assumed < 3; assumed++) {
+      std::vector<int> assumptions;
+      for (int i = 0; i < assumed; i++) assumptions.push_back (literal (vars));
+      for (auto lit : assumptions) reference.assume (lit), solver.assume (lit);
+      const int expected = reference.solve ();
+      const int res = solver.solve ();
+      if (res != expected) {
+        std::cerr << "seed " << seed << " round " << round
+                  << ": solver returns " << res << " but expected "
+                  << expected << " with";
+        for (const auto & option : options)
+          std::cerr << " --" << option.name << '=' << option.val;
+        std::cerr << std::endl;
+      }
+      assert (res == expected);
+      if (res == 10) check (solver, clauses, assumptions);
+    }
+  }
+}
+
+int main () {
+  for (const auto & options : configurations)
+    for (unsigned seed = 1; seed <= 10; seed++)
+      run (options, seed);
+  return 0;
+}
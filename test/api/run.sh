@@ -109,6 +109,7 @@ run terminate
 run learn
 run cfreeze
 run traverse
+run options
 run cipasir
 
 [ "`grep DNTRACING $makefile`" = "" ] && run apitrace
@@ -85,6 +85,8 @@ fi
 
 ok=0
 failed=0
+options=""
+proof=yes
 
 core () {
   msg "running CNF test core ${HILITE}'$1'${NORMAL}"
@@ -100,13 +102,13 @@ core () {
   else
     solopts=""
   fi
-  if [ ! $2 = 20 -o x"$proofchecker" = xnone ]
+  if [ ! $2 = 20 -o x"$proofchecker" = xnone -o x"$proof" = xno ]
   then
     proofopts=""
   else
     proofopts=" $prf"
   fi
-  opts="$cnf --check$solopts$proofopts"
+  opts="$cnf --check$options$solopts$proofopts"
   cecho "$coresolver \\"
   cecho "$opts"
   cecho -n "# $2 ..."
@@ -143,8 +145,10 @@ core () {
   elif [ $res = 20 ]
   then
     cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
-    if [ ! x"$proofchecker" = xnone ]
+    if [ x"$proofopts" = x ]
     then
+      ok=`expr $ok + 1`
+    else
       cecho "$proofchecker \\"
       cecho "$cnf $prf"
       cecho -n "# 0 ..."
@@ -207,6 +211,49 @@ run () {
   simp $*
 }
 
+# Run the core test with additional options, usually enabling procedures
+# which are disabled by default.  Procedures not producing proofs are
+# skipped if a proof is traced, thus the proof is not written nor checked
+# if they are tested 'without_proof'.
+
+with () {
+  options=" $1"
+  shift
+  core $*
+  options=""
+}
+
+without_proof () {
+  proof=no
+  with "$@"
+  proof=yes
+}
+
+# Run the core test with additional options as 'with' and further check
+# that the given statistics counter (printed in verbose mode) is positive,
+# i.e., that the tested procedure actually fired.
+
+fires () {
+  counter=$1
+  shift
+  with "-v $1" $2 $3
+  count=`grep "^c  *$counter: " $log | awk '{print $3}' | head -1`
+  cecho "grep '$counter:' $log"
+  cecho -n "# $counter ..."
+  if [ x"$count" = x ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (no '$counter' statistics)"
+    failed=`expr $failed + 1`
+  elif [ "$count" = 0 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} ('$counter' is zero)"
+    failed=`expr $failed + 1`
+  else
+    cecho " ${GOOD}ok${NORMAL} ($count $counter)"
+    ok=`expr $ok + 1`
+  fi
+}
+
 run empty 10
 run false 20
 
@@ -302,10 +349,108 @@ run add32 20
 run add64 20
 run add128 20
 
+run xor1 20
+run xor2 10
+
+run duplong1 10
+run duplong2 20
+
 run prime65537 20
 
 #--------------------------------------------------------------------------#
 
+fires subsigs "--subsumeint=100" add64 20
+fires subsigs "--subsumeint=100" prime2209 10
+fires transbatches "--subsumeint=100" add64 20
+fires transitive "--subsumeint=100" add64 20
+with "--subsumethreads=4 --subsumeint=100" add64 20
+with "--subsumethreads=4 --subsumeint=100" ph6 20
+fires elimcounted "--elimint=10" add64 20
+fires elimcounted "--elimint=10" prime2209 10
+fires elimdefs "--elimint=10" add64 20
+fires elimdefs "--elimint=10" prime2209 10
+fires lookups "--elimint=10" prime2209 10
+fires lookups "--probeint=10" add64 20
+fires ternary "--probeint=10" add64 20
+with "--elimthreads=4 --elimint=10" add64 20
+with "--elimthreads=4 --elimint=10" prime2209 10
+without_proof "--gauss=1 --probeint=1 --lucky=0 --checkproof=0" xor1 20
+without_proof "--gauss=1 --probeint=1 --lucky=0 --checkproof=0" xor2 10
+without_proof "--gauss=1 --probeint=1 --lucky=0 --check=0" xor1 20
+without_proof "--gauss=1 --probeint=1 --lucky=0 --check=0" xor2 10
+with "--xors=1" xor1 20
+with "--xors=1" xor2 10
+with "--xors=1 --check=0" xor1 20
+with "--xors=1 --check=0" xor2 10
+fires xors "--xors=1" add128 20
+with "--amo=1 --amominsize=3" ph6 20
+with "--amo=1 --amominsize=3" prime1849 10
+with "--amo=1 --amominsize=3 --check=0" ph6 20
+with "--amo=1 --amominsize=3 --check=0" prime1849 10
+fires amos "--amo=1 --amominsize=3" ph6 20
+fires flips "--rephaseint=10" add64 20
+fires flips "--rephaseint=10" prime2209 10
+with "--walkthread=1 --rephaseint=10" ph6 20
+with "--walkthread=1 --rephaseint=10" prime1849 10
+fires walkthreads "--walkthread=1 --rephaseint=10" add64 20
+with "--luckythreads=4" add64 20
+with "--luckythreads=4" sat13 10
+with "--luckythreads=4" factor2708413pos 10
+fires vivifymerged "--subsumeint=100" add128 20
+fires vivifymerged "--subsumeint=100" prime4294967297 20
+fires vivifyretier "--subsumeint=100" prime4294967297 20
+with "--block=1 --elimint=10 --elimocclim=0" add64 20
+with "--block=1 --elimint=10 --elimocclim=0" prime1369 10
+with "--block=1 --blockinc=0 --elimint=10 --elimocclim=0" add64 20
+with "--block=1 --blockinc=0 --elimint=10 --elimocclim=0" prime1369 10
+with "--cover=1 --elimint=10 --elimocclim=0" add32 20
+with "--cover=1 --elimint=10 --elimocclim=0" prime1849 10
+with "--cover=1 --covercache=0 --elimint=10 --elimocclim=0" add32 20
+with "--cover=1 --covercache=0 --elimint=10 --elimocclim=0" prime1849 10
+fires cached "--cover=1 --elimint=10 --elimocclim=0" add32 20
+fires cached "--cover=1 --elimint=10 --elimocclim=0" prime1849 10
+with "--condition=1 --conditionint=10" add32 20
+with "--condition=1 --conditionint=10" prime1849 10
+with "--condition=1 --conditionint=10 --conditionpure=0" add32 20
+with "--condition=1 --conditionint=10 --conditionpure=0" prime1849 10
+fires probetree "--probeint=10" add64 20
+fires probetree "--probeint=10" prime2209 10
+with "--decomposethreads=4 --probeint=10" add64 20
+with "--decomposethreads=4 --probeint=10" prime2209 10
+with "--probeint=10" duplong1 10
+with "--probeint=10" duplong2 20
+with "--probeint=10 --deduplicatelong=0" duplong1 10
+with "--probeint=10 --deduplicatelong=0" duplong2 20
+fires deduplong "--probeint=10" duplong1 10
+with "--lrb=3" add64 20
+with "--lrb=3" prime2209 10
+with "--lrb=3 --lrbbcp=1" add64 20
+with "--lrb=3 --lrbbcp=1" prime2209 10
+fires lrb "--lrb=3" add64 20
+fires lrb "--lrb=3" prime2209 10
+with "--restartrl=1 --restartrlint=50" add64 20
+with "--restartrl=1 --restartrlint=20" prime1849 10
+with "--restartrl=1 --restartrlint=50 --restartrlgeom=1 --restartrlluby=1" add64 20
+with "--restartrl=1 --restartrlint=20 --restartrlgeom=1 --restartrlluby=1" prime1849 10
+fires glue "--restartrl=1 --restartrlint=50" add64 20
+fires luby "--restartrl=1 --restartrlint=50" add64 20
+fires geometric "--restartrl=1 --restartrlint=50" add64 20
+with "--resets=1" add64 20
+with "--resets=1" prime2209 10
+fires full "--resets=1 --resetarm=1" add64 20
+fires decay "--resets=1 --resetarm=2" add64 20
+fires topk "--resets=1 --resetarm=3" add64 20
+fires noise "--resets=1 --resetarm=4" add64 20
+fires heapified "--resets=1 --resetarm=2" add64 20
+fires heapified "--shuffle=1" add64 20
+fires heapified "--resets=1 --resetarm=4" prime2209 10
+with "--reduceactivity=1 --reduceint=50" add64 20
+with "--reduceactivity=1 --reduceint=50" prime1849 10
+fires activity "--reduceactivity=1 --reduceint=50" add64 20
+fires activity "--reduceactivity=1 --reduceint=50" prime1849 10
+
+#--------------------------------------------------------------------------#
+
 [ $ok -gt 0 ] && OK="$GOOD"
 [ $failed -gt 0 ] && FAILED="$BAD"
 